@@ -0,0 +1,64 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "allocation_counter.hpp"
+
+#ifdef SCALE_ALLOCATION_STATS
+
+#include <scale/allocation_stats.hpp>
+
+// the library counts allocations made by encoding and decoding itself
+size_t scale::bench::allocationCount() {
+  return scale::allocationStats().allocations;
+}
+
+#else
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+  std::atomic<size_t> allocations{0};
+
+  void *allocate(size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (auto ptr = std::malloc(size == 0 ? 1 : size)) {
+      return ptr;
+    }
+    throw std::bad_alloc();
+  }
+}  // namespace
+
+size_t scale::bench::allocationCount() {
+  return allocations.load(std::memory_order_relaxed);
+}
+
+void *operator new(size_t size) {
+  return allocate(size);
+}
+
+void *operator new[](size_t size) {
+  return allocate(size);
+}
+
+void operator delete(void *ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete[](void *ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void *ptr, size_t) noexcept {
+  std::free(ptr);
+}
+
+void operator delete[](void *ptr, size_t) noexcept {
+  std::free(ptr);
+}
+
+#endif  // SCALE_ALLOCATION_STATS
@@ -0,0 +1,38 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <cstddef>
+
+#include <benchmark/benchmark.h>
+
+namespace scale::bench {
+
+  /**
+   * @return number of heap allocations made by the process so far
+   */
+  size_t allocationCount();
+
+  /**
+   * @brief counts heap allocations made since its construction and reports
+   * them as "allocs" counter averaged per iteration
+   */
+  class AllocationCounter {
+   public:
+    AllocationCounter() : start_{allocationCount()} {}
+
+    void report(benchmark::State &state) const {
+      state.counters["allocs"] = benchmark::Counter(
+          static_cast<double>(allocationCount() - start_),
+          benchmark::Counter::kAvgIterations);
+    }
+
+   private:
+    size_t start_;
+  };
+
+}  // namespace scale::bench
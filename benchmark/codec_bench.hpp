@@ -0,0 +1,83 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <cstdlib>
+
+#include <benchmark/benchmark.h>
+
+#include <scale/scale.hpp>
+
+#include "allocation_counter.hpp"
+
+namespace scale::bench {
+
+  /**
+   * @brief takes value of outcome::result, aborting benchmark on error
+   */
+  template <typename T>
+  auto valueOrAbort(outcome::result<T> result) {
+    if (result.has_error()) {
+      std::abort();
+    }
+    if constexpr (not std::is_void_v<T>) {
+      return std::move(result.value());
+    }
+  }
+
+  /**
+   * @brief benchmarks scale-encoding of value, made by Make for the size
+   * given by the benchmark argument
+   * @tparam Make function making value to encode from size_t
+   */
+  template <auto Make>
+  void encodeBench(benchmark::State &state) {
+    const auto value = Make(static_cast<size_t>(state.range(0)));
+    size_t bytes = 0;
+    AllocationCounter allocations;
+    for (auto _ : state) {
+      auto encoded = valueOrAbort(encode(value));
+      bytes += encoded.size();
+      benchmark::DoNotOptimize(encoded);
+    }
+    allocations.report(state);
+    state.SetBytesProcessed(static_cast<int64_t>(bytes));
+  }
+
+  /**
+   * @brief benchmarks scale-decoding of value, made by Make for the size
+   * given by the benchmark argument
+   * @tparam Make function making value to decode from size_t
+   */
+  template <auto Make>
+  void decodeBench(benchmark::State &state) {
+    using T = std::decay_t<decltype(Make(size_t{}))>;
+    const auto encoded =
+        valueOrAbort(encode(Make(static_cast<size_t>(state.range(0)))));
+    AllocationCounter allocations;
+    for (auto _ : state) {
+      auto decoded = valueOrAbort(decode<T>(encoded));
+      benchmark::DoNotOptimize(decoded);
+    }
+    allocations.report(state);
+    state.SetBytesProcessed(
+        static_cast<int64_t>(state.iterations() * encoded.size()));
+  }
+
+}  // namespace scale::bench
+
+/// Registers encoding and decoding benchmarks of value made by Make, the
+/// rest of arguments configures both of them, e.g. ->Range(1, 1 << 10)
+#define SCALE_CODEC_BENCHMARK(Make, ...)                                 \
+  [[maybe_unused]] static auto *const Make##_encode_bench =              \
+      benchmark::RegisterBenchmark("encode/" #Make,                      \
+                                   scale::bench::encodeBench<Make>)      \
+          __VA_ARGS__;                                                   \
+  [[maybe_unused]] static auto *const Make##_decode_bench =              \
+      benchmark::RegisterBenchmark("decode/" #Make,                      \
+                                   scale::bench::decodeBench<Make>)      \
+          __VA_ARGS__
@@ -0,0 +1,119 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <map>
+
+#include "codec_bench.hpp"
+
+using scale::BitVec;
+using scale::ByteArray;
+
+namespace {
+  struct Extrinsic {
+    uint32_t index;
+    uint64_t nonce;
+    std::string call;
+    std::optional<uint32_t> tip;
+    ByteArray signature;
+  };
+
+  template <class Stream,
+            typename = std::enable_if_t<Stream::is_encoder_stream>>
+  Stream &operator<<(Stream &s, const Extrinsic &v) {
+    return s << v.index << v.nonce << v.call << v.tip << v.signature;
+  }
+
+  template <class Stream,
+            typename = std::enable_if_t<Stream::is_decoder_stream>>
+  Stream &operator>>(Stream &s, Extrinsic &v) {
+    return s >> v.index >> v.nonce >> v.call >> v.tip >> v.signature;
+  }
+
+  using Variant = boost::variant<uint32_t, std::string, ByteArray>;
+
+  // argument of benchmarks is size of collection
+  std::string makeString(size_t n) {
+    return std::string(n, 'a');
+  }
+
+  ByteArray makeBytes(size_t n) {
+    ByteArray bytes(n);
+    for (size_t i = 0; i < n; ++i) {
+      bytes[i] = static_cast<uint8_t>(i);
+    }
+    return bytes;
+  }
+
+  std::vector<std::string> makeStrings(size_t n) {
+    std::vector<std::string> strings(n);
+    for (size_t i = 0; i < n; ++i) {
+      strings[i] = std::string(i % 64, 's');
+    }
+    return strings;
+  }
+
+  std::vector<Extrinsic> makeExtrinsics(size_t n) {
+    std::vector<Extrinsic> extrinsics(n);
+    for (size_t i = 0; i < n; ++i) {
+      extrinsics[i] = {static_cast<uint32_t>(i),
+                       i,
+                       std::string(16 + i % 32, 'c'),
+                       i % 2 == 0 ? std::optional<uint32_t>{} : uint32_t{7},
+                       ByteArray(64, 0x55)};
+    }
+    return extrinsics;
+  }
+
+  std::map<uint32_t, ByteArray> makeMap(size_t n) {
+    std::map<uint32_t, ByteArray> map;
+    for (size_t i = 0; i < n; ++i) {
+      map.emplace(static_cast<uint32_t>(i), ByteArray(32, 0xAA));
+    }
+    return map;
+  }
+
+  BitVec makeBitVec(size_t n) {
+    BitVec v(n);
+    for (size_t i = 0; i < n; i += 3) {
+      v.set(i);
+    }
+    return v;
+  }
+
+  std::vector<Variant> makeVariants(size_t n) {
+    std::vector<Variant> variants(n);
+    for (size_t i = 0; i < n; ++i) {
+      switch (i % 3) {
+        case 0:
+          variants[i] = static_cast<uint32_t>(i);
+          break;
+        case 1:
+          variants[i] = std::string(i % 32, 'v');
+          break;
+        default:
+          variants[i] = ByteArray(i % 32, 0x11);
+      }
+    }
+    return variants;
+  }
+
+  std::vector<std::optional<uint64_t>> makeOptionals(size_t n) {
+    std::vector<std::optional<uint64_t>> optionals(n);
+    for (size_t i = 0; i < n; i += 2) {
+      optionals[i] = i;
+    }
+    return optionals;
+  }
+}  // namespace
+
+SCALE_CODEC_BENCHMARK(makeString, ->Range(8, 1 << 20));
+SCALE_CODEC_BENCHMARK(makeBytes, ->Range(8, 1 << 20));
+SCALE_CODEC_BENCHMARK(makeStrings, ->Range(8, 1 << 14));
+SCALE_CODEC_BENCHMARK(makeExtrinsics, ->Range(8, 1 << 14));
+SCALE_CODEC_BENCHMARK(makeMap, ->Range(8, 1 << 14));
+SCALE_CODEC_BENCHMARK(makeBitVec, ->Range(8, 1 << 16));
+SCALE_CODEC_BENCHMARK(makeVariants, ->Range(8, 1 << 14));
+SCALE_CODEC_BENCHMARK(makeOptionals, ->Range(8, 1 << 14));
@@ -0,0 +1,174 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <scale/encode_append.hpp>
+
+#include "codec_bench.hpp"
+
+using scale::ByteArray;
+using scale::EncodeOpaqueValue;
+
+namespace {
+  /**
+   * @brief appends item to encoded vector of argument number of items,
+   * the vector is restored to the initial number of items periodically
+   */
+  void appendOrNewVecBench(benchmark::State &state) {
+    const auto item_count = static_cast<size_t>(state.range(0));
+    const auto item = scale::bench::valueOrAbort(scale::encode(uint32_t{42}));
+    const auto initial = scale::bench::valueOrAbort(scale::encode(
+        std::vector<EncodeOpaqueValue>(item_count, EncodeOpaqueValue{item})));
+    constexpr size_t kAppendsBeforeRestore = 1000;
+
+    auto self_encoded = initial;
+    size_t appends = 0;
+    scale::bench::AllocationCounter allocations;
+    for (auto _ : state) {
+      if (appends++ == kAppendsBeforeRestore) {
+        state.PauseTiming();
+        self_encoded = initial;
+        appends = 0;
+        state.ResumeTiming();
+      }
+      scale::bench::valueOrAbort(
+          scale::append_or_new_vec(self_encoded, item));
+      benchmark::DoNotOptimize(self_encoded.data());
+    }
+    allocations.report(state);
+    state.SetBytesProcessed(
+        static_cast<int64_t>(state.iterations() * item.size()));
+  }
+
+  /**
+   * @brief appends argument number of items to empty vector one by one or
+   * at once
+   */
+  template <bool kBatch>
+  void appendItemsBench(benchmark::State &state) {
+    const auto item_count = static_cast<size_t>(state.range(0));
+    const auto item = scale::bench::valueOrAbort(scale::encode(uint32_t{42}));
+    const std::vector<scale::ConstSpanOfBytes> inputs(item_count, item);
+
+    scale::bench::AllocationCounter allocations;
+    for (auto _ : state) {
+      ByteArray self_encoded;
+      if constexpr (kBatch) {
+        scale::bench::valueOrAbort(scale::append_many(self_encoded, inputs));
+      } else {
+        for (auto &input : inputs) {
+          scale::bench::valueOrAbort(
+              scale::append_or_new_vec(self_encoded, input));
+        }
+      }
+      benchmark::DoNotOptimize(self_encoded.data());
+    }
+    allocations.report(state);
+    state.SetBytesProcessed(static_cast<int64_t>(
+        state.iterations() * item_count * item.size()));
+  }
+
+  /**
+   * @brief appends argument number of items to AppendableEncodedVec one by
+   * one and takes the encoded vector
+   */
+  void appendableVecBench(benchmark::State &state) {
+    const auto item_count = static_cast<size_t>(state.range(0));
+    const auto item = scale::bench::valueOrAbort(scale::encode(uint32_t{42}));
+
+    scale::bench::AllocationCounter allocations;
+    for (auto _ : state) {
+      scale::AppendableEncodedVec vec;
+      for (size_t i = 0; i < item_count; ++i) {
+        vec.append(item);
+      }
+      auto self_encoded = vec.take();
+      benchmark::DoNotOptimize(self_encoded.data());
+    }
+    allocations.report(state);
+    state.SetBytesProcessed(static_cast<int64_t>(
+        state.iterations() * item_count * item.size()));
+  }
+
+  /**
+   * @brief reads back argument number of byte vectors appended to encoded
+   * vector, by decoding it or by viewing items in place
+   */
+  template <bool kView>
+  void readAppendedBench(benchmark::State &state) {
+    const auto item_count = static_cast<size_t>(state.range(0));
+    const auto item =
+        scale::bench::valueOrAbort(scale::encode(ByteArray(32, 0xEE)));
+    scale::AppendableEncodedVec vec;
+    for (size_t i = 0; i < item_count; ++i) {
+      vec.append(item);
+    }
+    const auto self_encoded = vec.take();
+
+    scale::bench::AllocationCounter allocations;
+    for (auto _ : state) {
+      size_t total = 0;
+      if constexpr (kView) {
+        auto view = scale::bench::valueOrAbort(
+            scale::decodeBorrowed<scale::LazyVec<scale::ConstSpanOfBytes>>(
+                self_encoded));
+        for (auto event : view) {
+          total += event.size();
+        }
+      } else {
+        auto events = scale::bench::valueOrAbort(
+            scale::decode<std::vector<ByteArray>>(self_encoded));
+        for (auto &event : events) {
+          total += event.size();
+        }
+      }
+      benchmark::DoNotOptimize(total);
+    }
+    allocations.report(state);
+    state.SetBytesProcessed(
+        static_cast<int64_t>(state.iterations() * self_encoded.size()));
+  }
+
+  /**
+   * @brief encodes vector of argument number of appended byte vectors,
+   * which bytes are written as is
+   */
+  void encodeAppendedBench(benchmark::State &state) {
+    const auto item_count = static_cast<size_t>(state.range(0));
+    const auto item =
+        scale::bench::valueOrAbort(scale::encode(ByteArray(32, 0xEE)));
+    scale::AppendableEncodedVec vec;
+    for (size_t i = 0; i < item_count; ++i) {
+      vec.append(item);
+    }
+
+    scale::bench::AllocationCounter allocations;
+    for (auto _ : state) {
+      auto encoded = scale::bench::valueOrAbort(scale::encode(vec));
+      benchmark::DoNotOptimize(encoded);
+    }
+    allocations.report(state);
+    state.SetBytesProcessed(
+        static_cast<int64_t>(state.iterations() * vec.encoded().size()));
+  }
+}  // namespace
+
+BENCHMARK(appendOrNewVecBench)->Name("append_or_new_vec")->Range(0, 1 << 16);
+BENCHMARK(appendItemsBench<false>)
+    ->Name("append_items/one_by_one")
+    ->Range(1, 1 << 14);
+BENCHMARK(appendItemsBench<true>)
+    ->Name("append_items/append_many")
+    ->Range(1, 1 << 14);
+BENCHMARK(appendableVecBench)
+    ->Name("append_items/appendable_vec")
+    ->Range(1, 1 << 14);
+BENCHMARK(readAppendedBench<false>)
+    ->Name("read_appended/decode")
+    ->Range(1, 1 << 14);
+BENCHMARK(readAppendedBench<true>)
+    ->Name("read_appended/view")
+    ->Range(1, 1 << 14);
+BENCHMARK(encodeAppendedBench)->Name("encode_appended")->Range(1, 1 << 14);
@@ -0,0 +1,83 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "codec_bench.hpp"
+
+using scale::Compact;
+using scale::CompactInteger;
+
+namespace {
+  // sizes of values of compact encoding categories: 1, 2, 4 and 5..8 bytes
+  constexpr std::array<uint64_t, 4> kCompactValues{
+      (1ull << 6) - 1, (1ull << 14) - 1, (1ull << 30) - 1, (1ull << 62) - 1};
+
+  // argument of integer benchmarks is number of values
+  std::vector<uint32_t> makeUint32s(size_t n) {
+    std::vector<uint32_t> values(n);
+    for (size_t i = 0; i < n; ++i) {
+      values[i] = static_cast<uint32_t>(i * 2654435761u);
+    }
+    return values;
+  }
+
+  std::vector<uint64_t> makeUint64s(size_t n) {
+    std::vector<uint64_t> values(n);
+    for (size_t i = 0; i < n; ++i) {
+      values[i] = i * 11400714819323198485ull;
+    }
+    return values;
+  }
+
+  std::tuple<uint8_t, uint16_t, uint32_t, uint64_t> makeIntegerTuple(
+      size_t n) {
+    return {static_cast<uint8_t>(n),
+            static_cast<uint16_t>(n),
+            static_cast<uint32_t>(n),
+            uint64_t{n}};
+  }
+
+  // argument of compact benchmarks is category of values: 0..3
+  std::vector<Compact<uint64_t>> makeCompacts(size_t category) {
+    return std::vector<Compact<uint64_t>>(1000, {kCompactValues[category]});
+  }
+
+  std::vector<CompactInteger> makeCompactIntegers(size_t category) {
+    return std::vector<CompactInteger>(1000, kCompactValues[category]);
+  }
+
+  // argument is number of bytes of big integer values: 9..32
+  std::vector<CompactInteger> makeBigCompactIntegers(size_t bytes) {
+    CompactInteger value = 1;
+    value <<= static_cast<unsigned>(bytes * 8 - 1);
+    return std::vector<CompactInteger>(1000, value);
+  }
+
+  // argument is number of values, which are u128 balances of 10..16 bytes
+  std::vector<CompactInteger> makeBalances(size_t n) {
+    std::vector<CompactInteger> values;
+    values.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+      CompactInteger value = i * 11400714819323198485ull;
+      value <<= 64;
+      value |= CompactInteger{(i + 1) * 14029467366897019727ull};
+      // keep exactly 10..16 bytes: drop higher bits, set the top one
+      const auto bits = static_cast<unsigned>(8 * (10 + i % 7));
+      CompactInteger top = 1;
+      top <<= bits - 1;
+      value &= top + (top - 1);
+      values.push_back(value | top);
+    }
+    return values;
+  }
+}  // namespace
+
+SCALE_CODEC_BENCHMARK(makeUint32s, ->Range(1, 1 << 16));
+SCALE_CODEC_BENCHMARK(makeUint64s, ->Range(1, 1 << 16));
+SCALE_CODEC_BENCHMARK(makeIntegerTuple, ->Arg(1));
+SCALE_CODEC_BENCHMARK(makeCompacts, ->DenseRange(0, 3));
+SCALE_CODEC_BENCHMARK(makeCompactIntegers, ->DenseRange(0, 3));
+SCALE_CODEC_BENCHMARK(makeBigCompactIntegers, ->Arg(9)->Arg(16)->Arg(32));
+SCALE_CODEC_BENCHMARK(makeBalances, ->Arg(1000));
@@ -0,0 +1,88 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <scale/parallel.hpp>
+
+#include "codec_bench.hpp"
+
+using scale::ByteArray;
+
+namespace {
+  // entry of state export: key and value of variable size
+  using Entry = std::pair<ByteArray, ByteArray>;
+
+  std::vector<Entry> makeEntries(size_t n) {
+    std::vector<Entry> entries(n);
+    for (size_t i = 0; i < n; ++i) {
+      entries[i] = {ByteArray(32, static_cast<uint8_t>(i)),
+                    ByteArray(16 + i % 256, 0x5A)};
+    }
+    return entries;
+  }
+
+  /**
+   * @brief decodes vector of 2^18 entries on the argument number of threads
+   */
+  void decodeParallelBench(benchmark::State &state) {
+    const auto threads = static_cast<size_t>(state.range(0));
+    const auto encoded =
+        scale::bench::valueOrAbort(scale::encode(makeEntries(1 << 18)));
+    for (auto _ : state) {
+      auto decoded = scale::bench::valueOrAbort(
+          scale::decodeParallel<Entry>(encoded, threads));
+      benchmark::DoNotOptimize(decoded);
+    }
+    state.SetBytesProcessed(
+        static_cast<int64_t>(state.iterations() * encoded.size()));
+  }
+
+  /**
+   * @brief encodes vector of 2^18 entries on the argument number of threads
+   */
+  void encodeParallelBench(benchmark::State &state) {
+    const auto threads = static_cast<size_t>(state.range(0));
+    const auto entries = makeEntries(1 << 18);
+    size_t bytes = 0;
+    for (auto _ : state) {
+      auto encoded = scale::bench::valueOrAbort(
+          scale::encodeParallel(entries, threads));
+      bytes += encoded.size();
+      benchmark::DoNotOptimize(encoded);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(bytes));
+  }
+
+  /**
+   * @brief allocates output of encodeParallel for 2^18 entries, which is
+   * zero-filled on one thread, to show its share of the encoding cost
+   */
+  void outputFillBench(benchmark::State &state) {
+    const auto size = scale::bench::valueOrAbort(
+        scale::encodedSize(makeEntries(1 << 18)));
+    for (auto _ : state) {
+      ByteArray out(size);
+      benchmark::DoNotOptimize(out.data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * size));
+  }
+}  // namespace
+
+BENCHMARK(outputFillBench)
+    ->Name("encode_parallel/output_fill")
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(encodeParallelBench)
+    ->Name("encode_parallel/entries")
+    ->RangeMultiplier(2)
+    ->Range(1, 32)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(decodeParallelBench)
+    ->Name("decode_parallel/entries")
+    ->RangeMultiplier(2)
+    ->Range(1, 32)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
@@ -26,7 +26,7 @@ class libscaleConan(ConanFile):
     generators = "CMakeDeps"
 
     # Sources are located in the same place as this recipe, copy them to the recipe
-    exports_sources = "CMakeLists.txt", "src/*", "include/*"
+    exports_sources = "CMakeLists.txt", "cmake/*", "src/*", "include/*"
 
     def config_options(self):
         if self.settings.os == "Windows":
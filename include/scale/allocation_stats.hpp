@@ -0,0 +1,68 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <cstddef>
+
+namespace scale {
+
+  /**
+   * @brief heap allocations made by scale::encode and scale::decode calls
+   */
+  struct AllocationStats {
+    size_t allocations = 0;
+    size_t bytes = 0;
+
+    bool operator==(const AllocationStats &) const = default;
+  };
+
+  // SCALE_ALLOCATION_STATS is defined for executables linking the
+  // scale_allocation_stats target, which is made by the option of the same
+  // name and replaces global operator new of the program
+#ifdef SCALE_ALLOCATION_STATS
+
+  /**
+   * @return allocations made by encoding and decoding on the current thread
+   * since its start or the last reset
+   */
+  AllocationStats allocationStats();
+
+  /**
+   * @brief resets allocation counters of the current thread
+   */
+  void resetAllocationStats();
+
+  namespace detail {
+    /**
+     * @brief attributes allocations made on the current thread while it is
+     * alive to encoding and decoding, nested scopes are counted once
+     */
+    class AllocationScope {
+     public:
+      AllocationScope();
+      AllocationScope(const AllocationScope &) = delete;
+      AllocationScope &operator=(const AllocationScope &) = delete;
+      ~AllocationScope();
+    };
+  }  // namespace detail
+
+#else
+
+  /// Allocations are not counted unless built with SCALE_ALLOCATION_STATS
+  inline AllocationStats allocationStats() {
+    return {};
+  }
+
+  inline void resetAllocationStats() {}
+
+  namespace detail {
+    class AllocationScope {};
+  }  // namespace detail
+
+#endif
+
+}  // namespace scale
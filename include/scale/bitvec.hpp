@@ -6,17 +6,146 @@
 
 #pragma once
 
+#include <algorithm>
+#include <bit>
+#include <initializer_list>
 #include <vector>
 
+#include <scale/types.hpp>
+
 namespace scale {
   /**
-   * @brief Bit vector encoding compatible with rust `BitVec<u8, Lsb0>`
+   * @brief Bit vector encoding compatible with rust `BitVec<u8, Lsb0>`.
+   * Bits are packed to bytes in the same order as they are encoded: bit i
+   * is stored in byte i / 8 at position i % 8 from the least significant
+   * one, so encoding and decoding copy the bytes at once.
+   * Unused bits of the last byte are always zero.
    */
-  struct BitVec {
-    std::vector<bool> bits;
+  class BitVec {
+   public:
+    BitVec() = default;
+
+    BitVec(std::initializer_list<bool> bits) {
+      reserve(bits.size());
+      for (auto bit : bits) {
+        push_back(bit);
+      }
+    }
+
+    explicit BitVec(const std::vector<bool> &bits) {
+      reserve(bits.size());
+      for (auto bit : bits) {
+        push_back(bit);
+      }
+    }
+
+    explicit BitVec(size_t size, bool value = false) {
+      resize(size, value);
+    }
+
+    size_t size() const {
+      return size_;
+    }
+
+    bool empty() const {
+      return size_ == 0;
+    }
+
+    /**
+     * @brief value of bit by index, which must be less than size()
+     */
+    bool operator[](size_t index) const {
+      return ((bytes_[index / 8] >> (index % 8)) & 1u) != 0;
+    }
+
+    /**
+     * @brief sets value of bit by index, which must be less than size()
+     */
+    void set(size_t index, bool value = true) {
+      auto mask = static_cast<uint8_t>(1u << (index % 8));
+      if (value) {
+        bytes_[index / 8] |= mask;
+      } else {
+        bytes_[index / 8] &= static_cast<uint8_t>(~mask);
+      }
+    }
+
+    void push_back(bool value) {
+      if (size_ % 8 == 0) {
+        bytes_.push_back(0);
+      }
+      set(size_++, value);
+    }
 
-    bool operator==(const BitVec &other) const {
-      return bits == other.bits;
+    void reserve(size_t size) {
+      bytes_.reserve(byteCount(size));
     }
+
+    void resize(size_t size, bool value = false) {
+      auto old_size = size_;
+      if (value and size > old_size) {
+        // set the rest of the last byte before adding filled bytes
+        for (; old_size < size and old_size % 8 != 0; ++old_size) {
+          bytes_.back() |= static_cast<uint8_t>(1u << (old_size % 8));
+        }
+      }
+      bytes_.resize(byteCount(size), value ? 0xFF : 0);
+      size_ = size;
+      clearUnusedBits();
+    }
+
+    void clear() {
+      bytes_.clear();
+      size_ = 0;
+    }
+
+    /**
+     * @return number of set bits
+     */
+    size_t count() const {
+      size_t count = 0;
+      for (auto byte : bytes_) {
+        count += static_cast<size_t>(std::popcount(byte));
+      }
+      return count;
+    }
+
+    /**
+     * @return bytes with packed bits
+     */
+    ConstSpanOfBytes bytes() const {
+      return bytes_;
+    }
+
+    /**
+     * @brief replaces bits by given number of bits packed in bytes
+     * @param size number of bits
+     * @param bytes packed bits, must contain (size + 7) / 8 bytes, unused
+     * bits of the last byte are ignored
+     */
+    void assign(size_t size, ConstSpanOfBytes bytes) {
+      bytes_.assign(bytes.begin(), bytes.begin() + byteCount(size));
+      size_ = size;
+      clearUnusedBits();
+    }
+
+    bool operator==(const BitVec &other) const = default;
+
+    /**
+     * @return number of bytes to pack given number of bits
+     */
+    static constexpr size_t byteCount(size_t size) {
+      return size / 8 + (size % 8 != 0 ? 1 : 0);
+    }
+
+   private:
+    void clearUnusedBits() {
+      if (size_ % 8 != 0) {
+        bytes_.back() &= static_cast<uint8_t>((1u << (size_ % 8)) - 1);
+      }
+    }
+
+    std::vector<uint8_t> bytes_;
+    size_t size_ = 0;
   };
 }  // namespace scale
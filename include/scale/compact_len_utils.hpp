@@ -0,0 +1,63 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <bit>
+#include <concepts>
+#include <limits>
+
+#include <scale/types.hpp>
+
+namespace scale::compact {
+  /**
+   * @brief number of bytes required to represent the value, by position of
+   * its most significant bit
+   * @return number of bytes, 1 for zero
+   */
+  constexpr size_t countBytes(uint64_t v) {
+    return v == 0 ? 1 : (static_cast<size_t>(std::bit_width(v)) + 7) / 8;
+  }
+
+  constexpr size_t countBytes(const CompactInteger &v) {
+    if (v.is_zero()) {
+      return 1;
+    }
+    return static_cast<size_t>(msb(v)) / 8 + 1;
+  }
+
+  /**
+   * Returns the compact encoded length for the given value.
+   */
+  template <NativeCompactInteger T>
+  constexpr size_t compactLen(T val) {
+    using Limits = EncodingCategoryLimits;
+    const auto v = static_cast<uint64_t>(val);
+    if (v < Limits::kMinUint16) {
+      return 1;
+    }
+    if (v < Limits::kMinUint32) {
+      return 2;
+    }
+    if (v < Limits::kMinBigInteger) {
+      return 4;
+    }
+    return 1 + countBytes(v);
+  }
+
+  /// bool and signed integers can not be compact-encoded, the overload
+  /// prevents their conversion to CompactInteger
+  template <std::integral T>
+    requires(not NativeCompactInteger<T>)
+  constexpr size_t compactLen(T val) = delete;
+
+  constexpr size_t compactLen(const CompactInteger &val) {
+    if (val <= std::numeric_limits<uint64_t>::max()) {
+      return compactLen(static_cast<uint64_t>(val));
+    }
+    return 1 + countBytes(val);
+  }
+}  // namespace scale::compact
@@ -0,0 +1,114 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+
+#include <boost/endian/conversion.hpp>
+
+#include <scale/compact_len_utils.hpp>
+#include <scale/outcome/outcome.hpp>
+#include <scale/types.hpp>
+
+namespace scale::detail {
+  /// Max size of compact-encoded integer: header byte and up to 67 bytes
+  constexpr size_t kMaxCompactIntegerSize = 68;
+
+  /// Buffer which is enough to fit any compact-encoded integer
+  using CompactIntegerBuffer = std::array<uint8_t, kMaxCompactIntegerSize>;
+
+  /**
+   * @brief compact-encodes CompactInteger to buffer
+   * @param value source CompactInteger value
+   * @param out buffer to write encoded value to
+   * @return number of bytes written to the buffer or error if the value
+   * can not be compact-encoded
+   */
+  outcome::result<size_t> encodeCompactInteger(const CompactInteger &value,
+                                               CompactIntegerBuffer &out);
+
+  /**
+   * @brief stores least significant bytes of CompactInteger in little-endian
+   * order, copying limbs of its representation without wide arithmetic
+   * @param value source value
+   * @param out buffer to fill, up to 32 bytes
+   */
+  inline void storeCompactIntegerBytes(const CompactInteger &value,
+                                       std::span<uint8_t> out) {
+    using Limb = CompactInteger::limb_type;
+    size_t offset = 0;
+    for (auto limb : value.crepresentation()) {
+      if (offset >= out.size()) {
+        break;
+      }
+      const auto size = std::min(sizeof(Limb), out.size() - offset);
+      limb = boost::endian::native_to_little(limb);
+      std::memcpy(out.data() + offset, &limb, size);
+      offset += size;
+    }
+  }
+
+  /**
+   * @brief loads CompactInteger from little-endian bytes, filling limbs of
+   * its representation without wide arithmetic
+   * @param bytes source bytes, those beyond 32 least significant are ignored
+   * @return loaded value
+   */
+  inline CompactInteger loadCompactIntegerBytes(ConstSpanOfBytes bytes) {
+    using Limb = CompactInteger::limb_type;
+    CompactInteger value{0u};
+    size_t offset = 0;
+    for (auto &limb : value.representation()) {
+      if (offset >= bytes.size()) {
+        break;
+      }
+      const auto size = std::min(sizeof(Limb), bytes.size() - offset);
+      Limb loaded = 0;
+      std::memcpy(&loaded, bytes.data() + offset, size);
+      limb = boost::endian::little_to_native(loaded);
+      offset += size;
+    }
+    return value;
+  }
+
+  /// Max size of compact-encoded 64-bit integer: header byte and 8 bytes
+  constexpr size_t kMaxNativeCompactSize = 9;
+
+  /// Buffer which is enough to fit any compact-encoded native integer
+  using NativeCompactBuffer = std::array<uint8_t, kMaxNativeCompactSize>;
+
+  /**
+   * @brief compact-encodes native unsigned integer to buffer without
+   * wide integer arithmetic
+   * @param value source value
+   * @param out buffer to write encoded value to
+   * @return number of bytes written to the buffer
+   */
+  inline size_t encodeCompactInteger(uint64_t value,
+                                     NativeCompactBuffer &out) {
+    using compact::EncodingCategoryLimits;
+    if (value < EncodingCategoryLimits::kMinBigInteger) {
+      // mode 0b00, 0b01 or 0b10 stands for 1, 2 or 4 bytes of encoded value
+      const auto mode =
+          static_cast<uint32_t>(value >= EncodingCategoryLimits::kMinUint16)
+          + static_cast<uint32_t>(value >= EncodingCategoryLimits::kMinUint32);
+      boost::endian::endian_store<uint32_t, 4, boost::endian::order::little>(
+          out.data(), (static_cast<uint32_t>(value) << 2u) | mode);
+      return size_t{1} << mode;
+    }
+    // mode 0b11, 6 major bits of header store number of bytes minus 4
+    const size_t bytes = compact::countBytes(value);
+    out[0] = static_cast<uint8_t>(((bytes - 4) << 2u) | 0b11u);
+    boost::endian::endian_store<uint64_t, 8, boost::endian::order::little>(
+        out.data() + 1, value);
+    return 1 + bytes;
+  }
+}  // namespace scale::detail
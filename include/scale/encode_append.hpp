@@ -6,27 +6,14 @@
 
 #pragma once
 
+#include <vector>
+
+#include <scale/detail/compact_integer.hpp>
 #include <scale/outcome/outcome.hpp>
 #include <scale/types.hpp>
 
 namespace scale {
 
-  /**
-   * Vector wrapper, that is scale encoded without prepended CompactInteger
-   */
-  struct EncodeOpaqueValue {
-    ConstSpanOfBytes v;
-  };
-
-  template <class Stream,
-            typename = std::enable_if_t<Stream::is_encoder_stream>>
-  Stream &operator<<(Stream &s, const EncodeOpaqueValue &value) {
-    for (auto &&it = value.v.begin(), end = value.v.end(); it != end; ++it) {
-      s << *it;
-    }
-    return s;
-  }
-
   /**
    * Adds an EncodeOpaqueValue to a scale encoded vector of EncodeOpaqueValue's.
    * If the current vector is empty, then it is replaced by a new
@@ -45,4 +32,96 @@ namespace scale {
    */
   outcome::result<void> append_or_new_vec(std::vector<uint8_t> &self_encoded,
                                           ConstSpanOfBytes input);
+
+  /**
+   * Adds several EncodeOpaqueValue's to a scale encoded vector of
+   * EncodeOpaqueValue's, the result is the same as of adding them one by one
+   * by append_or_new_vec, but the final size is reserved at once and the
+   * length prefix is rewritten, with moving of the encoded items if the
+   * prefix gets longer, only once
+   * @param self_encoded - An encoded vector of EncodeOpaqueValue, possibly
+   * empty
+   * @param inputs - Vectors encoded as EncodeOpaqueValue's and added to
+   * \param self_encoded in order
+   * @return success if inputs were appended to self_encoded, failure
+   * otherwise
+   */
+  outcome::result<void> append_many(std::vector<uint8_t> &self_encoded,
+                                    std::span<const ConstSpanOfBytes> inputs);
+
+  /**
+   * Scale encoded vector of EncodeOpaqueValue's, which items are appended
+   * in amortized O(1) time.
+   * Encoded items are stored after a slot, which fits the longest length
+   * prefix, and the prefix is kept at the end of the slot, so the encoded
+   * vector is available without copying, while its items are never moved
+   * because of the prefix getting longer
+   */
+  class AppendableEncodedVec {
+   public:
+    AppendableEncodedVec();
+
+    /**
+     * @brief makes vector from the encoded one, e.g. made by
+     * append_or_new_vec
+     * @param encoded - An encoded vector of EncodeOpaqueValue, empty data
+     * means empty vector
+     * @return vector or error if the length prefix can not be decoded
+     */
+    static outcome::result<AppendableEncodedVec> fromEncoded(
+        ConstSpanOfBytes encoded);
+
+    /**
+     * @return number of items
+     */
+    size_t size() const {
+      return size_;
+    }
+
+    /**
+     * Adds EncodeOpaqueValue to the vector
+     * @param input - A vector encoded as EncodeOpaqueValue
+     */
+    void append(ConstSpanOfBytes input);
+
+    /**
+     * Adds several EncodeOpaqueValue's to the vector
+     * @param inputs - Vectors encoded as EncodeOpaqueValue's
+     */
+    void append(std::span<const ConstSpanOfBytes> inputs);
+
+    /**
+     * @return encoded vector with the shortest length prefix, valid until
+     * the vector is changed
+     */
+    ConstSpanOfBytes encoded() const {
+      return ConstSpanOfBytes{buffer_}.subspan(kMaxPrefixSize - prefix_size_);
+    }
+
+    /**
+     * Moves encoded vector out, moving the items once to remove the unused
+     * part of the length prefix slot, the vector becomes empty afterwards
+     * @return encoded vector with the shortest length prefix
+     */
+    std::vector<uint8_t> take();
+
+    /**
+     * @brief scale-encodes the vector as encoded items of the vector
+     */
+    template <class Stream,
+              typename = std::enable_if_t<Stream::is_encoder_stream>>
+    friend Stream &operator<<(Stream &s, const AppendableEncodedVec &v) {
+      return s << EncodeOpaqueValue{v.encoded()};
+    }
+
+   private:
+    static constexpr size_t kMaxPrefixSize = detail::kMaxNativeCompactSize;
+
+    /// writes length prefix for the current number of items
+    void updatePrefix();
+
+    std::vector<uint8_t> buffer_;
+    size_t size_ = 0;
+    size_t prefix_size_ = 0;
+  };
 }  // namespace scale
@@ -90,13 +90,14 @@ namespace scale {
             typename = std::enable_if_t<S::is_decoder_stream>,
             typename = std::enable_if_t<std::is_enum_v<E>>>
   S &operator>>(S &s, T &v) {
-    std::underlying_type_t<E> value;
+    std::underlying_type_t<E> value{};
     s >> value;
     if (is_valid_enum_value<E>(value)) {
       v = static_cast<E>(value);
       return s;
     }
-    raise(DecodeError::INVALID_ENUM_VALUE);
+    s.fail(DecodeError::INVALID_ENUM_VALUE);
+    return s;
   }
 
 }  // namespace scale
@@ -0,0 +1,335 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <optional>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <scale/scale.hpp>
+
+namespace scale {
+
+  /**
+   * @brief tells if decoded value of type T keeps views into decoded data,
+   * either itself or in its nested values of standard types. Values of
+   * other types, e.g. structures, are not inspected
+   * @tparam T type of value
+   */
+  template <typename T>
+  struct HoldsView : std::false_type {};
+
+  template <typename T>
+  constexpr bool kHoldsView = HoldsView<std::remove_const_t<T>>::value;
+
+  template <typename T>
+  struct HoldsView<LazyVec<T>> : std::true_type {};
+
+  template <>
+  struct HoldsView<std::string_view> : std::true_type {};
+
+  template <>
+  struct HoldsView<ConstSpanOfBytes> : std::true_type {};
+
+  template <typename T>
+  struct HoldsView<std::optional<T>> : std::bool_constant<kHoldsView<T>> {};
+
+  template <typename T, typename A>
+  struct HoldsView<std::vector<T, A>> : std::bool_constant<kHoldsView<T>> {};
+
+  template <typename F, typename S>
+  struct HoldsView<std::pair<F, S>>
+      : std::bool_constant<kHoldsView<F> or kHoldsView<S>> {};
+
+  template <typename... Ts>
+  struct HoldsView<std::tuple<Ts...>>
+      : std::bool_constant<(kHoldsView<Ts> or ...)> {};
+
+  namespace detail {
+    template <typename T>
+    struct IsOptional : std::false_type {};
+
+    template <typename T>
+    struct IsOptional<std::optional<T>> : std::true_type {};
+
+    template <typename T>
+    struct IsTupleLike : std::false_type {};
+
+    template <typename F, typename S>
+    struct IsTupleLike<std::pair<F, S>> : std::true_type {};
+
+    template <typename... Ts>
+    struct IsTupleLike<std::tuple<Ts...>> : std::true_type {};
+
+    template <typename T>
+    constexpr bool resumableCollection() {
+      if constexpr (DynamicCollection<T>) {
+        // items of static size are passed at once with the collection
+        return not HasStaticEncodedSize<std::ranges::range_value_t<T>>;
+      } else {
+        return false;
+      }
+    }
+
+    /**
+     * @brief tells if scanning of value of type T may be resumed from the
+     * middle of it, other values are passed at once
+     */
+    template <typename T>
+    constexpr bool kResumableScan =
+        not HasStaticEncodedSize<T>
+        and (resumableCollection<T>()
+             or (IsOptional<T>::value
+                 and not std::is_same_v<T, std::optional<bool>>)
+             or IsTupleLike<T>::value);
+  }  // namespace detail
+
+  /**
+   * @brief decoder of a value of type T, which data comes in chunks.
+   * Each chunk is checked for completing the value by passing its encoded
+   * parts without decoding them. If the value is not complete yet, the
+   * number of missing bytes is reported and the data is not rescanned until
+   * at least that many bytes are fed. Progress is saved at each nesting
+   * level of collections, optionals, pairs and tuples, so their parts, which
+   * are already passed, are not rescanned at all. Values of other types,
+   * e.g. structures and variants, are passed at once, so such a value is
+   * rescanned from its beginning on each refill until it is complete.
+   * The value is decoded at once when all its data is available, directly
+   * from the fed chunk if it contains the whole value.
+   * Decoded value must own its data, because neither the chunk nor the
+   * buffered data outlives it, so types keeping views are rejected.
+   * @tparam T type of decoded value
+   */
+  template <typename T>
+  class IncrementalDecoder {
+    static_assert(not kHoldsView<T>,
+                  "decoded value would refer to data released after decoding");
+
+   public:
+    /**
+     * @brief feeds next chunk of data
+     * @param chunk data, which is not referenced after the call
+     * @return number of bytes, which are missing at least to complete the
+     * value, or 0 when the value is decoded and may be taken
+     */
+    outcome::result<size_t> feed(ConstSpanOfBytes chunk) {
+      if (value_) {
+        buffer_.insert(buffer_.end(), chunk.begin(), chunk.end());
+        return 0;
+      }
+
+      if (buffer_.empty()) {
+        // try to decode the value directly from the chunk
+#ifdef _WIN32
+        size_t size;
+#endif
+        OUTCOME_TRY(size, scan(chunk));
+        if (size == 0) {
+          OUTCOME_TRY(decodeFrom(chunk));
+          buffer_.assign(chunk.begin() + encoded_size_, chunk.end());
+          return 0;
+        }
+        buffer_.assign(chunk.begin(), chunk.end());
+        return size;
+      }
+
+      buffer_.insert(buffer_.end(), chunk.begin(), chunk.end());
+      if (buffer_.size() < required_size_) {
+        return required_size_ - buffer_.size();
+      }
+#ifdef _WIN32
+      size_t size;
+#endif
+      OUTCOME_TRY(size, scan(buffer_));
+      if (size != 0) {
+        return size;
+      }
+      OUTCOME_TRY(decodeFrom(buffer_));
+      buffer_.erase(buffer_.begin(),
+                    buffer_.begin() + static_cast<ptrdiff_t>(encoded_size_));
+      return 0;
+    }
+
+    /**
+     * @return true if the value is decoded
+     */
+    bool done() const {
+      return value_.has_value();
+    }
+
+    /**
+     * @brief takes decoded value and prepares for decoding of the next one
+     * from the data remaining after it
+     * @return decoded value, must be called only when done() is true
+     */
+    T take() {
+      T value = std::move(*value_);
+      value_.reset();
+      resetScan();
+      return value;
+    }
+
+    /**
+     * @return fed data, which is not consumed yet
+     */
+    ConstSpanOfBytes remaining() const {
+      return buffer_;
+    }
+
+    /**
+     * @brief drops any fed data and decoding state
+     */
+    void reset() {
+      buffer_.clear();
+      value_.reset();
+      resetScan();
+    }
+
+   private:
+    /**
+     * @brief passes encoded value in data from the point where previous scan
+     * stopped
+     * @return number of missing bytes or 0 if the whole value is passed
+     */
+    outcome::result<size_t> scan(ConstSpanOfBytes data) {
+      ScaleDecoderStream s{data};
+      s.setThrowOnError(false);
+      s.seek(offset_);
+      pass<T>(s, 0);
+      if (s.error()) {
+        if (s.error() != DecodeError::NOT_ENOUGH_DATA) {
+          return outcome::failure(s.error());
+        }
+        // at least one more byte is missing, whatever the stream reports
+        required_size_ = std::max(s.requiredSize(), data.size() + 1);
+        return required_size_ - data.size();
+      }
+      encoded_size_ = s.currentIndex();
+      return 0;
+    }
+
+    /**
+     * @brief passes value of type U, resuming from the progress saved at
+     * given nesting level, and saves progress made in it
+     * @return true if the whole value is passed
+     */
+    template <typename U>
+    bool pass(ScaleDecoderStream &s, size_t level) {
+      if constexpr (not detail::kResumableScan<U>) {
+        s.skip<U>();
+        if (s.error()) {
+          return false;
+        }
+        offset_ = s.currentIndex();
+        return true;
+      } else {
+        if (levels_.size() == level) {
+          levels_.emplace_back();
+        }
+        if constexpr (DynamicCollection<U>) {
+          using Item = std::remove_const_t<std::ranges::range_value_t<U>>;
+          if (not levels_[level].item_count) {
+            auto item_count = s.decodeLength();
+            if (s.error()) {
+              return false;
+            }
+            levels_[level].item_count = item_count;
+            offset_ = s.currentIndex();
+          }
+          while (levels_[level].passed < *levels_[level].item_count) {
+            if (not pass<Item>(s, level + 1)) {
+              return false;
+            }
+            ++levels_[level].passed;
+          }
+        } else if constexpr (detail::IsOptional<U>::value) {
+          if (levels_[level].passed == 0) {
+            bool has_value = false;
+            s >> has_value;
+            if (s.error()) {
+              return false;
+            }
+            // 1 if the value is to be passed, 2 if there is no value
+            levels_[level].passed = has_value ? 1 : 2;
+            offset_ = s.currentIndex();
+          }
+          if (levels_[level].passed == 1
+              and not pass<std::remove_const_t<typename U::value_type>>(
+                  s, level + 1)) {
+            return false;
+          }
+        } else {
+          if (not passElements<U>(
+                  s, level, std::make_index_sequence<std::tuple_size_v<U>>{})) {
+            return false;
+          }
+        }
+        levels_.pop_back();
+        return true;
+      }
+    }
+
+    template <typename U, size_t... I>
+    bool passElements(ScaleDecoderStream &s,
+                      size_t level,
+                      std::index_sequence<I...>) {
+      return (passElement<std::remove_const_t<std::tuple_element_t<I, U>>, I>(
+                  s, level)
+              and ...);
+    }
+
+    template <typename E, size_t I>
+    bool passElement(ScaleDecoderStream &s, size_t level) {
+      if (levels_[level].passed > I) {
+        return true;
+      }
+      if (not pass<E>(s, level + 1)) {
+        return false;
+      }
+      levels_[level].passed = I + 1;
+      return true;
+    }
+
+    outcome::result<void> decodeFrom(ConstSpanOfBytes data) {
+      ScaleDecoderStream s{data.first(encoded_size_)};
+      s.setThrowOnError(false);
+      T value{};
+      OUTCOME_TRY(decode(s, value));
+      value_.emplace(std::move(value));
+      return outcome::success();
+    }
+
+    void resetScan() {
+      levels_.clear();
+      offset_ = 0;
+      required_size_ = 0;
+      encoded_size_ = 0;
+    }
+
+    std::vector<uint8_t> buffer_;
+    std::optional<T> value_;
+
+    /// progress of scanning of partially passed value at its nesting level
+    struct Level {
+      /// number of items of collection, once its length is passed
+      std::optional<size_t> item_count;
+      /// number of passed items or elements, or state of optional
+      size_t passed = 0;
+    };
+
+    // state of scanning, which allows not to pass the same data twice
+    std::vector<Level> levels_;
+    size_t offset_ = 0;
+    size_t required_size_ = 0;
+    size_t encoded_size_ = 0;
+  };
+
+}  // namespace scale
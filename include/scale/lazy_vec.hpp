@@ -0,0 +1,244 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/throw_exception.hpp>
+
+#include <scale/encode_append.hpp>
+#include <scale/scale_decoder_stream.hpp>
+#include <scale/static_encoded_size.hpp>
+#include <scale/types.hpp>
+
+namespace scale {
+
+  /**
+   * @brief scale-encoded vector of items, which are decoded on access.
+   * Decoding of LazyVec only finds the bounds of encoded items and checks
+   * their values the same way skip() does, then keeps a view to them, so it
+   * is decoded only by borrowing stream, e.g. by decodeBorrowed(), and the
+   * decoded data must outlive it.
+   * Offsets of items of dynamic size are indexed while decoding, so that
+   * const access is thread-safe; iterators decode items one by one.
+   * LazyVec<ConstSpanOfBytes> decoded by decodeBorrowed() walks a vector of
+   * byte vectors, e.g. made by append_or_new_vec, without allocations.
+   * @tparam T type of item
+   */
+  template <typename T>
+  class LazyVec {
+   public:
+    using value_type = T;
+    using size_type = size_t;
+
+    class Iterator {
+     public:
+      using iterator_category = std::input_iterator_tag;
+      using value_type = T;
+      using difference_type = std::ptrdiff_t;
+      using reference = T;
+
+      Iterator() = default;
+
+      T operator*() const {
+        auto stream = vec_->itemStream(offset_);
+        T item{};
+        stream >> item;
+        next_offset_ = offset_ + stream.currentIndex();
+        return item;
+      }
+
+      Iterator &operator++() {
+        offset_ = nextOffset();
+        next_offset_.reset();
+        ++index_;
+        return *this;
+      }
+
+      /**
+       * @return encoded bytes of the current item, without decoding it
+       */
+      ConstSpanOfBytes encoded() const {
+        return vec_->items_.subspan(offset_, nextOffset() - offset_);
+      }
+
+      void operator++(int) {
+        ++*this;
+      }
+
+      bool operator==(const Iterator &other) const {
+        return index_ == other.index_;
+      }
+
+     private:
+      friend class LazyVec;
+
+      size_t nextOffset() const {
+        if (not next_offset_) {
+          auto stream = vec_->itemStream(offset_);
+          stream.template skip<T>();
+          next_offset_ = offset_ + stream.currentIndex();
+        }
+        return *next_offset_;
+      }
+
+      Iterator(const LazyVec *vec, size_t index, size_t offset)
+          : vec_{vec}, index_{index}, offset_{offset} {}
+
+      const LazyVec *vec_ = nullptr;
+      size_t index_ = 0;
+      size_t offset_ = 0;
+      // end of the current item, if it is already known
+      mutable std::optional<size_t> next_offset_;
+    };
+
+    LazyVec() = default;
+
+    size_t size() const {
+      return size_;
+    }
+
+    bool empty() const {
+      return size_ == 0;
+    }
+
+    /**
+     * @return encoded items without length prefix
+     */
+    ConstSpanOfBytes encodedItems() const {
+      return items_;
+    }
+
+    /**
+     * @brief decodes item by index, which must be less than size()
+     */
+    T operator[](size_t index) const {
+      auto stream = itemStream(offsetOf(index));
+      T item{};
+      stream >> item;
+      return item;
+    }
+
+    /**
+     * @brief decodes item by index
+     * @throws std::out_of_range if index is not less than size()
+     */
+    T at(size_t index) const {
+      if (index >= size_) {
+        boost::throw_exception(
+            std::out_of_range("LazyVec index is out of range"));
+      }
+      return (*this)[index];
+    }
+
+    /**
+     * @brief takes encoded bytes of item by index without decoding it, so
+     * that it may be decoded as any type or passed as is
+     * @param index index of item, which must be less than size()
+     * @return encoded item
+     */
+    ConstSpanOfBytes encodedItem(size_t index) const {
+      auto offset = offsetOf(index);
+      auto end = index + 1 < size_ ? offsetOf(index + 1) : items_.size();
+      return items_.subspan(offset, end - offset);
+    }
+
+    Iterator begin() const {
+      return {this, 0, 0};
+    }
+
+    Iterator end() const {
+      return {this, size_, items_.size()};
+    }
+
+    /**
+     * @brief scale-decodes LazyVec by passing its items without decoding
+     * @param s stream to decode from
+     * @param v LazyVec to be set
+     * @return reference to stream
+     */
+    friend ScaleDecoderStream &operator>>(ScaleDecoderStream &s,
+                                          LazyVec &v) {
+      // views taken in skip mode are never exposed
+      if (not s.isBorrowing() and not s.isSkipping()) {
+        s.fail(DecodeError::BORROWING_NOT_ALLOWED);
+        return s;
+      }
+      auto size = s.decodeLength();
+      auto begin = s.currentIndex();
+      if constexpr (UncheckedEncoding<T>) {
+        constexpr auto item_size = static_encoded_size_v<T>;
+        if (not s.requireMore(
+                size > std::numeric_limits<size_t>::max() / item_size
+                    ? std::numeric_limits<uint64_t>::max()
+                    : size * item_size)) {
+          return s;
+        }
+        s.seek(size * item_size);
+      } else {
+        // offsets of items of static size are computed, placeholders made
+        // in skip mode are not indexed
+        const bool index = not HasStaticEncodedSize<T> and not s.isSkipping();
+        v.offsets_.clear();
+        if (index) {
+          // the length is checked against the rest of data, so it bounds
+          // the reserved size
+          v.offsets_.reserve(size);
+        }
+        // items are validated here, so that decoding them on access succeeds
+        for (size_t i = 0; i < size and not s.error(); ++i) {
+          if (index) {
+            v.offsets_.push_back(s.currentIndex() - begin);
+          }
+          s.skip<T>();
+        }
+      }
+      if (s.error()) {
+        return s;
+      }
+      v.items_ = s.span().subspan(begin, s.currentIndex() - begin);
+      v.size_ = size;
+      return s;
+    }
+
+    /**
+     * @brief scale-encodes LazyVec by copying its encoded items
+     * @param s stream to encode to
+     * @param v LazyVec to be encoded
+     * @return reference to stream
+     */
+    template <class Stream,
+              typename = std::enable_if_t<Stream::is_encoder_stream>>
+    friend Stream &operator<<(Stream &s, const LazyVec &v) {
+      return s << Compact<size_t>{v.size_} << EncodeOpaqueValue{v.items_};
+    }
+
+   private:
+    ScaleDecoderStream itemStream(size_t offset) const {
+      return ScaleDecoderStream{items_.subspan(offset), kBorrowInput};
+    }
+
+    size_t offsetOf(size_t index) const {
+      if constexpr (HasStaticEncodedSize<T>) {
+        return index * static_encoded_size_v<T>;
+      } else {
+        return offsets_[index];
+      }
+    }
+
+    ConstSpanOfBytes items_;
+    size_t size_ = 0;
+    // offsets of encoded items of dynamic size, indexed while decoding
+    std::vector<size_t> offsets_;
+  };
+
+}  // namespace scale
@@ -0,0 +1,57 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <string>
+
+#include <scale/outcome/outcome.hpp>
+#include <scale/types.hpp>
+
+namespace scale {
+
+  /**
+   * @class MappedFile maps file to memory for reading, so that large
+   * encoded data is decoded from it by ScaleDecoderStream without reading
+   * the whole file first.
+   * Pages are read from disk lazily on first access, the mapping is
+   * advised to be accessed sequentially, so the kernel reads ahead and
+   * drops passed pages first. Windows gets the same hint when the file is
+   * opened.
+   */
+  class MappedFile {
+   public:
+    /**
+     * @brief maps the whole file
+     * @param path path to file
+     * @return mapped file or system error
+     */
+    static outcome::result<MappedFile> open(const std::string &path);
+
+    MappedFile(MappedFile &&other) noexcept;
+    MappedFile &operator=(MappedFile &&other) noexcept;
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    ~MappedFile();
+
+    /**
+     * @return content of the file, valid while the file is mapped
+     */
+    ConstSpanOfBytes data() const {
+      return {data_, size_};
+    }
+
+   private:
+    MappedFile(const uint8_t *data, size_t size) : data_{data}, size_{size} {}
+
+    void unmap();
+
+    const uint8_t *data_ = nullptr;
+    size_t size_ = 0;
+  };
+
+}  // namespace scale
@@ -9,7 +9,13 @@
 #pragma warning(push)
 #pragma warning(disable : 4583)
 #pragma warning(disable : 4582)
+#include <boost/config.hpp>
+#ifdef BOOST_NO_EXCEPTIONS
+// full Outcome requires boost::exception_ptr, which needs exceptions
+#include <boost/outcome/std_result.hpp>
+#else
 #include <boost/outcome/outcome.hpp>
+#endif
 #include <boost/outcome/try.hpp>
 #pragma warning(pop)
 
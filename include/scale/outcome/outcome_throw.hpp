@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <boost/config.hpp>
 #include <boost/throw_exception.hpp>
 #include <system_error>
 
@@ -13,4 +14,12 @@ namespace scale {
   [[noreturn]] inline void raise(const std::error_code &ec) {
     boost::throw_exception(std::system_error(ec));
   }
+
+  /// Whether streams raise errors as exceptions by default, otherwise they
+  /// only record errors in their state
+#ifdef BOOST_NO_EXCEPTIONS
+  inline constexpr bool kThrowOnErrorByDefault = false;
+#else
+  inline constexpr bool kThrowOnErrorByDefault = true;
+#endif
 }  // namespace scale
@@ -0,0 +1,318 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <limits>
+#include <new>
+#include <numeric>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include <scale/scale.hpp>
+
+namespace scale {
+
+  namespace detail {
+    /// Number of chunks of work per thread, so that threads which got
+    /// cheaper chunks take more of them
+    constexpr size_t kChunksPerThread = 4;
+
+    /// Min number of items in chunk, smaller collections are not worth
+    /// starting threads for
+    constexpr size_t kMinChunkItems = 64;
+
+    /**
+     * @param threads requested number of threads, 0 for the number of
+     * hardware threads
+     * @return number of threads to use
+     */
+    inline size_t threadCount(size_t threads) {
+      if (threads == 0) {
+        threads = std::thread::hardware_concurrency();
+      }
+      return std::max<size_t>(threads, 1);
+    }
+
+    /**
+     * @param item_count number of items in collection
+     * @param threads number of threads
+     * @return number of chunks to split the collection to
+     */
+    inline size_t chunkCount(size_t item_count, size_t threads) {
+      auto chunks = (item_count + kMinChunkItems - 1) / kMinChunkItems;
+      return std::min(chunks, threads * kChunksPerThread);
+    }
+
+    /**
+     * @param item_count number of items in collection
+     * @param chunk_count number of chunks
+     * @param chunk index of chunk
+     * @return index of the first item of chunk
+     */
+    inline size_t chunkBegin(size_t item_count,
+                             size_t chunk_count,
+                             size_t chunk) {
+      // item_count * chunk may overflow
+      return item_count / chunk_count * chunk
+           + item_count % chunk_count * chunk / chunk_count;
+    }
+
+    /**
+     * @brief runs task for each chunk on given number of threads including
+     * the calling one, threads take next chunk as they finish previous.
+     * Exception thrown by the task is rethrown on the calling thread after
+     * all the threads are joined, the first one in order of chunks.
+     * If threads can not be started, the chunks are taken by those already
+     * running and the calling one.
+     * @param chunk_count number of chunks
+     * @param threads number of threads
+     * @param task function taking index of chunk
+     */
+    template <typename F>
+    void parallelFor(size_t chunk_count, size_t threads, const F &task) {
+      std::atomic<size_t> next_chunk{0};
+      std::vector<std::exception_ptr> exceptions(chunk_count);
+      auto work = [&] {
+        for (auto chunk = next_chunk.fetch_add(1, std::memory_order_relaxed);
+             chunk < chunk_count;
+             chunk = next_chunk.fetch_add(1, std::memory_order_relaxed)) {
+#ifndef BOOST_NO_EXCEPTIONS
+          try {
+#endif
+            task(chunk);
+#ifndef BOOST_NO_EXCEPTIONS
+          } catch (...) {
+            // exception escaping a thread would terminate the program
+            exceptions[chunk] = std::current_exception();
+          }
+#endif
+        }
+      };
+      std::vector<std::thread> workers;
+      workers.reserve(std::min(threads, chunk_count));
+#ifndef BOOST_NO_EXCEPTIONS
+      try {
+#endif
+        for (size_t i = 1; i < threads and i < chunk_count; ++i) {
+          workers.emplace_back(work);
+        }
+#ifndef BOOST_NO_EXCEPTIONS
+      } catch (const std::system_error &) {
+        // no more threads, the started ones are joined below
+      }
+#endif
+      work();
+      for (auto &worker : workers) {
+        worker.join();
+      }
+#ifndef BOOST_NO_EXCEPTIONS
+      for (auto &exception : exceptions) {
+        if (exception) {
+          std::rethrow_exception(exception);
+        }
+      }
+#endif
+    }
+
+    /**
+     * @return first error in order of chunks, if any
+     */
+    inline outcome::result<void> firstError(
+        const std::vector<std::error_code> &errors) {
+      for (auto &error : errors) {
+        if (error) {
+          return outcome::failure(error);
+        }
+      }
+      return outcome::success();
+    }
+  }  // namespace detail
+
+  /**
+   * @brief decodes vector of items on several threads.
+   * Encoded items are passed without decoding to find the bounds of chunks
+   * of items, then chunks are decoded independently. Result is the same as
+   * of decode<std::vector<T>>(data)
+   * @tparam T type of item, not bool, which items of std::vector share
+   * bytes, so they can not be written by different threads
+   * @param data span of bytes with encoded vector
+   * @param threads number of threads, 0 for the number of hardware threads
+   * @return decoded vector
+   */
+  template <typename T>
+  outcome::result<std::vector<T>> decodeParallel(ConstSpanOfBytes data,
+                                                 size_t threads = 0) {
+    static_assert(not std::is_same_v<T, bool>,
+                  "items of std::vector<bool> can not be decoded in parallel");
+    ScaleDecoderStream s{data};
+    s.setThrowOnError(false);
+    size_t item_count = 0;
+    OUTCOME_TRY(streamCatch(s, [&] { item_count = s.decodeLength(); }));
+    if (item_count == 0) {
+      return outcome::success(std::vector<T>{});
+    }
+    threads = detail::threadCount(threads);
+    const auto chunk_count = detail::chunkCount(item_count, threads);
+
+    // offsets of the first items of chunks and the end of the last one
+    std::vector<size_t> bounds;
+    bounds.reserve(chunk_count + 1);
+    if constexpr (HasStaticEncodedSize<T>) {
+      constexpr auto item_size = static_encoded_size_v<T>;
+      if (item_size != 0
+          and (item_count > std::numeric_limits<size_t>::max() / item_size
+               or not s.hasMore(item_count * item_size))) {
+        return DecodeError::NOT_ENOUGH_DATA;
+      }
+      for (size_t chunk = 0; chunk <= chunk_count; ++chunk) {
+        bounds.push_back(
+            s.currentIndex()
+            + detail::chunkBegin(item_count, chunk_count, chunk) * item_size);
+      }
+    } else {
+      OUTCOME_TRY(streamCatch(s, [&] {
+        size_t item = 0;
+        for (size_t chunk = 0; chunk < chunk_count; ++chunk) {
+          bounds.push_back(s.currentIndex());
+          auto end = detail::chunkBegin(item_count, chunk_count, chunk + 1);
+          for (; item < end and not s.error(); ++item) {
+            s.skip<T>();
+          }
+        }
+        bounds.push_back(s.currentIndex());
+      }));
+    }
+
+    std::vector<T> items;
+    if (item_count > items.max_size()) {
+      return DecodeError::TOO_MANY_ITEMS;
+    }
+#ifndef BOOST_NO_EXCEPTIONS
+    try {
+#endif
+      items.resize(item_count);
+#ifndef BOOST_NO_EXCEPTIONS
+    } catch (const std::bad_alloc &) {
+      return DecodeError::TOO_MANY_ITEMS;
+    }
+#endif
+    std::vector<std::error_code> errors(chunk_count);
+    OUTCOME_TRY(outcomeCatch([&] {
+      detail::parallelFor(chunk_count, threads, [&](size_t chunk) {
+        ScaleDecoderStream cs{
+            data.subspan(bounds[chunk], bounds[chunk + 1] - bounds[chunk])};
+        cs.setThrowOnError(false);
+        auto end = detail::chunkBegin(item_count, chunk_count, chunk + 1);
+        auto res = streamCatch(cs, [&] {
+          for (auto item = detail::chunkBegin(item_count, chunk_count, chunk);
+               item < end and not cs.error();
+               ++item) {
+            cs >> items[item];
+          }
+        });
+        if (res.has_error()) {
+          errors[chunk] = res.error();
+        } else if (cs.hasMore(1)) {
+          // items take less data than was passed by the pre-scan
+          errors[chunk] = make_error_code(DecodeError::UNEXPECTED_VALUE);
+        }
+      });
+    }));
+    OUTCOME_TRY(detail::firstError(errors));
+    return outcome::success(std::move(items));
+  }
+
+  /**
+   * @brief encodes vector of items on several threads.
+   * Encoded sizes of chunks of items are counted first, then the output is
+   * allocated at once and chunks are encoded to their places in it
+   * independently. Result is the same as of encode(items).
+   * The output is ByteArray, which zero-fills its bytes on allocation, so
+   * that one serial pass over the output is part of the cost, see the
+   * encode_parallel/output_fill benchmark.
+   * @tparam T type of item
+   * @param items vector to encode
+   * @param threads number of threads, 0 for the number of hardware threads
+   * @return encoded vector
+   */
+  template <typename T>
+  outcome::result<ByteArray> encodeParallel(const std::vector<T> &items,
+                                            size_t threads = 0) {
+    if (items.empty()) {
+      return encode(items);
+    }
+    threads = detail::threadCount(threads);
+    const auto item_count = items.size();
+    const auto chunk_count = detail::chunkCount(item_count, threads);
+    auto encodeChunk = [&](auto &s, size_t chunk) {
+      auto end = detail::chunkBegin(item_count, chunk_count, chunk + 1);
+      return streamCatch(s, [&] {
+        for (auto item = detail::chunkBegin(item_count, chunk_count, chunk);
+             item < end and not s.error();
+             ++item) {
+          s << items[item];
+        }
+      });
+    };
+
+    // offsets of encoded chunks, the first one follows the length prefix
+    std::vector<size_t> offsets(chunk_count + 1);
+    ScaleEncodeCounter header;
+    header << Compact<size_t>{item_count};
+    offsets[0] = header.size();
+    std::vector<std::error_code> errors(chunk_count);
+    if constexpr (HasStaticEncodedSize<T>) {
+      for (size_t chunk = 0; chunk < chunk_count; ++chunk) {
+        offsets[chunk + 1] =
+            static_encoded_size_v<T>
+            * (detail::chunkBegin(item_count, chunk_count, chunk + 1)
+               - detail::chunkBegin(item_count, chunk_count, chunk));
+      }
+    } else {
+      OUTCOME_TRY(outcomeCatch([&] {
+        detail::parallelFor(chunk_count, threads, [&](size_t chunk) {
+          ScaleEncodeCounter s;
+          s.setThrowOnError(false);
+          auto res = encodeChunk(s, chunk);
+          if (res.has_error()) {
+            errors[chunk] = res.error();
+          }
+          offsets[chunk + 1] = s.size();
+        });
+      }));
+      OUTCOME_TRY(detail::firstError(errors));
+    }
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+    // serial zero fill, all the bytes are overwritten below
+    ByteArray out(offsets.back());
+    ScaleSpanEncoderStream header_stream{out};
+    header_stream << Compact<size_t>{item_count};
+    OUTCOME_TRY(outcomeCatch([&] {
+      detail::parallelFor(chunk_count, threads, [&](size_t chunk) {
+        auto size = offsets[chunk + 1] - offsets[chunk];
+        ScaleSpanEncoderStream s{
+            MutSpanOfBytes{out}.subspan(offsets[chunk], size)};
+        s.setThrowOnError(false);
+        auto res = encodeChunk(s, chunk);
+        if (res.has_error()) {
+          errors[chunk] = res.error();
+        } else if (s.size() != size) {
+          // items are encoded to other size than was counted
+          errors[chunk] = make_error_code(EncodeError::BUFFER_TOO_SMALL);
+        }
+      });
+    }));
+    OUTCOME_TRY(detail::firstError(errors));
+    return outcome::success(std::move(out));
+  }
+
+}  // namespace scale
@@ -9,10 +9,15 @@
 #include <boost/system/system_error.hpp>
 #include <boost/throw_exception.hpp>
 
+#include <scale/allocation_stats.hpp>
 #include <scale/enum_traits.hpp>
+#include <scale/lazy_vec.hpp>
 #include <scale/outcome/outcome.hpp>
 #include <scale/scale_decoder_stream.hpp>
+#include <scale/scale_encode_counter.hpp>
 #include <scale/scale_encoder_stream.hpp>
+#include <scale/scale_sink_encoder_stream.hpp>
+#include <scale/scale_span_encoder_stream.hpp>
 
 #define SCALE_EMPTY_DECODER(TargetType)                             \
   template <typename Stream,                                        \
@@ -35,16 +40,38 @@
 namespace scale {
   template <typename F>
   outcome::result<std::invoke_result_t<F>> outcomeCatch(F &&f) {
+#ifndef BOOST_NO_EXCEPTIONS
     try {
+#endif
       if constexpr (std::is_void_v<std::invoke_result_t<F>>) {
         f();
         return outcome::success();
       } else {
         return outcome::success(f());
       }
+#ifndef BOOST_NO_EXCEPTIONS
     } catch (std::system_error &e) {
       return outcome::failure(e.code());
     }
+#endif
+  }
+
+  /**
+   * @brief runs encoding or decoding operation on the stream, taking the
+   * error either raised or recorded in the stream state, allocations made
+   * by the operation are counted in allocationStats()
+   * @param s stream
+   * @param f operation
+   * @return error of the operation, if any
+   */
+  template <typename Stream, typename F>
+  outcome::result<void> streamCatch(Stream &s, F &&f) {
+    [[maybe_unused]] detail::AllocationScope allocation_scope;
+    OUTCOME_TRY(outcomeCatch(std::forward<F>(f)));
+    if (s.error()) {
+      return outcome::failure(s.error());
+    }
+    return outcome::success();
   }
 
   /**
@@ -56,12 +83,68 @@ namespace scale {
   template <typename... Args>
   outcome::result<std::vector<uint8_t>> encode(Args &&...args) {
     ScaleEncoderStream s{};
+    s.setThrowOnError(false);
     OUTCOME_TRY(encode(s, std::forward<Args>(args)...));
-    return s.to_vector();
+    return s.take();
   }
   template <typename... Args>
   outcome::result<void> encode(ScaleEncoderStream &s, Args &&...args) {
-    return outcomeCatch([&] { (s << ... << std::forward<Args>(args)); });
+    return streamCatch(s, [&] { (s << ... << std::forward<Args>(args)); });
+  }
+
+  /**
+   * @brief convenience function for calculating size of encoded data without
+   * encoding it
+   * @tparam Args types to be encoded
+   * @param args data to encode
+   * @return size of encoded data in bytes
+   */
+  template <typename... Args>
+  outcome::result<size_t> encodedSize(Args &&...args) {
+    ScaleEncodeCounter s{};
+    s.setThrowOnError(false);
+    OUTCOME_TRY(
+        streamCatch(s, [&] { (s << ... << std::forward<Args>(args)); }));
+    return s.size();
+  }
+
+  /**
+   * @brief encodes value, which encoded size is known at compile time,
+   * to array on the stack without heap allocations
+   * @tparam T type having static encoded size
+   * @param value value to encode
+   * @return array of encoded bytes
+   */
+  template <HasStaticEncodedSize T>
+  std::array<uint8_t, static_encoded_size_v<T>> encodeFixed(const T &value) {
+    std::array<uint8_t, static_encoded_size_v<T>> out{};
+    ScaleSpanEncoderStream s{out};
+    s << value;
+    if (s.overflowed()) {
+      raise(EncodeError::BUFFER_TOO_SMALL);
+    }
+    return out;
+  }
+
+  /**
+   * @brief convenience function for encoding data to caller-provided buffer
+   * without heap allocations
+   * @tparam Args types to be encoded
+   * @param out buffer to write encoded data to
+   * @param args data to encode
+   * @return number of bytes written or EncodeError::BUFFER_TOO_SMALL
+   * @note use ScaleSpanEncoderStream directly to get the required size
+   */
+  template <typename... Args>
+  outcome::result<size_t> encodeTo(MutSpanOfBytes out, Args &&...args) {
+    ScaleSpanEncoderStream s{out};
+    s.setThrowOnError(false);
+    OUTCOME_TRY(
+        streamCatch(s, [&] { (s << ... << std::forward<Args>(args)); }));
+    if (s.overflowed()) {
+      return EncodeError::BUFFER_TOO_SMALL;
+    }
+    return s.size();
   }
 
   /**
@@ -73,16 +156,65 @@ namespace scale {
   template <class T>
   outcome::result<T> decode(ConstSpanOfBytes data) {
     ScaleDecoderStream s(data);
+    s.setThrowOnError(false);
+    return decode<T>(s);
+  }
+  /**
+   * @brief convenience function for decoding data to allocator-aware value
+   * (e.g. std::pmr containers), which nested values are allocated from
+   * the given memory resource
+   * @tparam T type that is decoded from provided span
+   * @param data span of bytes with encoded data
+   * @param resource memory resource for the decoded value
+   * @return decoded T
+   */
+  template <class T>
+  outcome::result<T> decode(ConstSpanOfBytes data,
+                            std::pmr::memory_resource *resource) {
+    ScaleDecoderStream s(data);
+    s.setThrowOnError(false);
+    s.setMemoryResource(resource);
+    return decode<T>(s);
+  }
+
+  /**
+   * @brief convenience function for decoding data without copying strings
+   * and byte collections, which are decoded as std::string_view and
+   * std::span<const uint8_t> views into the data
+   * @tparam T type that is decoded from provided span
+   * @param data span of bytes with encoded data, must outlive decoded value
+   * @return decoded T
+   */
+  template <class T>
+  outcome::result<T> decodeBorrowed(ConstSpanOfBytes data) {
+    ScaleDecoderStream s(data, kBorrowInput);
+    s.setThrowOnError(false);
     return decode<T>(s);
   }
+
+  /**
+   * @brief finds size of value of type T encoded at the beginning of data
+   * without decoding it
+   * @tparam T type of encoded value
+   * @param data span of bytes with encoded data
+   * @return number of bytes occupied by encoded value
+   */
+  template <class T>
+  outcome::result<size_t> encodedLength(ConstSpanOfBytes data) {
+    ScaleDecoderStream s(data);
+    s.setThrowOnError(false);
+    OUTCOME_TRY(streamCatch(s, [&] { s.skip<T>(); }));
+    return s.currentIndex();
+  }
+
   template <typename T>
   outcome::result<T> decode(ScaleDecoderStream &s) {
-    T t{};
+    T t = s.makeValue<T>();
     OUTCOME_TRY(decode<T>(s, t));
     return outcome::success(std::move(t));
   }
   template <typename T>
   outcome::result<void> decode(ScaleDecoderStream &s, T &t) {
-    return outcomeCatch([&] { s >> t; });
+    return streamCatch(s, [&] { s >> t; });
   }
 }  // namespace scale
@@ -6,37 +6,196 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <cassert>
 #include <iterator>
+#include <limits>
 #include <memory>
+#include <memory_resource>
 #include <optional>
+#include <string_view>
 #include <utility>
+#include <variant>
 
+#include <boost/core/no_exceptions_support.hpp>
 #include <boost/variant.hpp>
 
 #include <scale/bitvec.hpp>
 #include <scale/detail/fixed_width_integer.hpp>
 #include <scale/scale_error.hpp>
+#include <scale/static_encoded_size.hpp>
 #include <scale/types.hpp>
 #include <type_traits>
 
 namespace scale {
+  /**
+   * @brief tag to construct decoder stream, which decodes std::string_view
+   * and std::span<const uint8_t> values as views into its input data
+   */
+  struct BorrowInputTag {};
+  inline constexpr BorrowInputTag kBorrowInput{};
+
   class ScaleDecoderStream {
    public:
     // special tag to differentiate decoding streams from others
     static constexpr auto is_decoder_stream = true;
 
     explicit ScaleDecoderStream(ConstSpanOfBytes data)
-        : span_{data}, current_index_{0} {}
+        : span_{data},
+          data_size_{data.size()},
+          current_index_{0},
+          borrowing_{false},
+          skipping_{false} {}
+
+    /**
+     * Initializes stream, which decodes std::string_view and
+     * std::span<const uint8_t> values as views into the data without copying.
+     * The data must outlive decoded values.
+     * @param data data to decode
+     */
+    ScaleDecoderStream(ConstSpanOfBytes data, BorrowInputTag)
+        : span_{data},
+          data_size_{data.size()},
+          current_index_{0},
+          borrowing_{true},
+          skipping_{false} {}
+
+    /**
+     * @return true if the stream decodes views into its input data
+     */
+    bool isBorrowing() const {
+      return borrowing_;
+    }
+
+    /**
+     * @return true if the stream passes values by skip() without
+     * materializing them
+     */
+    bool isSkipping() const {
+      return skipping_;
+    }
+
+    /**
+     * @brief sets whether the stream raises errors as exceptions, which is
+     * the default unless exceptions are disabled, or only records them
+     * @param enable true to raise errors
+     */
+    void setThrowOnError(bool enable) {
+      throw_on_error_ = enable;
+    }
+
+    bool throwsOnError() const {
+      return throw_on_error_;
+    }
+
+    /**
+     * @brief sets memory resource for values, which are made by the stream
+     * itself while decoding (top-level values of scale::decode, values of
+     * optionals, variants and pointers, items of maps and sets). Values
+     * supporting uses-allocator construction with
+     * std::pmr::polymorphic_allocator get it, their nested items are
+     * allocated by their allocators then
+     * @param resource memory resource or nullptr for default construction
+     */
+    void setMemoryResource(std::pmr::memory_resource *resource) {
+      memory_resource_ = resource;
+    }
+
+    std::pmr::memory_resource *memoryResource() const {
+      return memory_resource_;
+    }
+
+    /**
+     * @brief makes value to be decoded using memory resource of the stream,
+     * if it is set and the value is allocator-aware
+     * @tparam T type of value
+     * @return default-constructed value
+     */
+    template <typename T>
+    T makeValue() const {
+      if constexpr (std::uses_allocator_v<T,
+                                          std::pmr::polymorphic_allocator<>>) {
+        if (memory_resource_ != nullptr) {
+          return std::make_obj_using_allocator<T>(
+              std::pmr::polymorphic_allocator<>{memory_resource_});
+        }
+      }
+      return T{};
+    }
+
+    /**
+     * @return the first error occurred during decoding, if any
+     */
+    const std::error_code &error() const {
+      return error_;
+    }
+
+    /**
+     * @brief reports decoding error: raises it if the stream throws on
+     * errors, otherwise records the first one and exhausts the stream, so
+     * that decoding of the rest fails quickly without reading any data
+     * @param error error to report
+     */
+    void fail(std::error_code error) {
+#ifndef BOOST_NO_EXCEPTIONS
+      if (throw_on_error_) {
+        raise(error);
+      }
+#endif
+      if (not error_) {
+        error_ = error;
+        span_ = span_.first(current_index_);
+      }
+    }
+
+    /**
+     * @brief advances the stream over encoded value of type T without
+     * materializing it: values of statically known encoded size which accept
+     * any bytes are skipped at once, collections are passed by their length
+     * prefixes, other values are decoded into default-constructed
+     * placeholders which are never filled with items. Bounds and values,
+     * e.g. of bool and enums, are still validated.
+     * @tparam T type of encoded value
+     * @return reference to stream
+     */
+    template <typename T>
+    ScaleDecoderStream &skip() {
+      using mutableT = std::remove_const_t<T>;
+      [[maybe_unused]] const auto begin = current_index_;
+      if constexpr (UncheckedEncoding<mutableT>) {
+        skipBytes(static_encoded_size_v<mutableT>);
+      } else {
+        static_assert(std::is_default_constructible_v<mutableT>);
+        SkipModeGuard guard{*this};
+        mutableT placeholder{};
+        *this >> placeholder;
+      }
+      // lengths are checked against the rest of data, so they never wrap
+      assert(current_index_ >= begin and current_index_ <= span_.size());
+      return *this;
+    }
 
     template <typename T>
     T decodeCompact() {
-      // TODO(turuslan): don't allocate cpp_int
-      scale::CompactInteger big;
-      *this >> big;
-      if (not big.is_zero() and msb(big) >= std::numeric_limits<T>::digits) {
-        raise(DecodeError::TOO_MANY_ITEMS);
+      if constexpr (std::is_integral_v<T>
+                    and sizeof(T) <= sizeof(uint64_t)) {
+        auto value = decodeCompactUint64();
+        if (value > static_cast<uint64_t>(std::numeric_limits<T>::max())) {
+          fail(DecodeError::TOO_MANY_ITEMS);
+          return 0;
+        }
+        return static_cast<T>(value);
+      } else {
+        scale::CompactInteger big;
+        *this >> big;
+        if (not big.is_zero()
+            and msb(big) >= std::numeric_limits<T>::digits) {
+          fail(DecodeError::TOO_MANY_ITEMS);
+          return 0;
+        }
+        return static_cast<T>(big);
       }
-      return static_cast<T>(big);
     }
 
     size_t decodeLength();
@@ -51,6 +210,7 @@ namespace scale {
     template <class F, class S>
     ScaleDecoderStream &operator>>(std::pair<F, S> &p) {
       static_assert(!std::is_reference_v<F> && !std::is_reference_v<S>);
+      ensureStaticEncodedSize<std::pair<F, S>>();
       return *this >> const_cast<std::remove_const_t<F> &>(p.first)  // NOLINT
              >> const_cast<std::remove_const_t<S> &>(p.second);      // NOLINT
     }
@@ -63,6 +223,7 @@ namespace scale {
      */
     template <class... T>
     ScaleDecoderStream &operator>>(std::tuple<T...> &v) {
+      ensureStaticEncodedSize<std::tuple<T...>>();
       if constexpr (sizeof...(T) > 0) {
         decodeElementOfTuple<0>(v);
       }
@@ -83,10 +244,37 @@ namespace scale {
 
       // ensure that index is in [0, types_count)
       if (type_index >= sizeof...(Ts)) {
-        raise(DecodeError::WRONG_TYPE_INDEX);
+        fail(DecodeError::WRONG_TYPE_INDEX);
+        return *this;
+      }
+
+      decodeVariant(v, type_index, std::index_sequence_for<Ts...>{});
+      return *this;
+    }
+
+    /**
+     * @brief scale-decoding of std::variant, which is encoded the same way
+     * as boost::variant
+     * @tparam T enumeration of various types
+     * @param v reference to variant
+     * @return reference to stream
+     */
+    template <class... Ts>
+    ScaleDecoderStream &operator>>(std::variant<Ts...> &v) {
+      uint8_t type_index = 0u;
+      *this >> type_index;
+      if (type_index >= sizeof...(Ts)) {
+        fail(DecodeError::WRONG_TYPE_INDEX);
+        return *this;
       }
+      decodeVariant(v, type_index, std::index_sequence_for<Ts...>{});
+      return *this;
+    }
 
-      tryDecodeAsOneOfVariant<0>(v, type_index);
+    /**
+     * @brief scale-decodes empty alternative of std::variant from nothing
+     */
+    ScaleDecoderStream &operator>>(std::monostate &) {
       return *this;
     }
 
@@ -102,7 +290,15 @@ namespace scale {
 
       static_assert(std::is_default_constructible_v<mutableT>);
 
-      v = std::make_shared<mutableT>();
+      if (skipping_) {
+        return skip<mutableT>();
+      }
+      if (memory_resource_ != nullptr) {
+        v = std::allocate_shared<mutableT>(
+            std::pmr::polymorphic_allocator<mutableT>{memory_resource_});
+      } else {
+        v = std::make_shared<mutableT>();
+      }
       return *this >> const_cast<mutableT &>(*v);  // NOLINT
     }
 
@@ -118,7 +314,16 @@ namespace scale {
 
       static_assert(std::is_default_constructible_v<mutableT>);
 
-      v = std::make_unique<mutableT>();
+      if (skipping_) {
+        return skip<mutableT>();
+      }
+      if constexpr (std::uses_allocator_v<
+                        mutableT,
+                        std::pmr::polymorphic_allocator<>>) {
+        v = std::make_unique<mutableT>(makeValue<mutableT>());
+      } else {
+        v = std::make_unique<mutableT>();
+      }
       return *this >> const_cast<mutableT &>(*v);  // NOLINT
     }
 
@@ -143,8 +348,9 @@ namespace scale {
         return *this;
       }
       // decode any other integer
-      if (not hasMore(sizeof(T))) {
-        raise(DecodeError::NOT_ENOUGH_DATA);
+      if (not requireMore(sizeof(T))) {
+        v = 0;
+        return *this;
       }
       v = boost::endian::
           endian_load<T, sizeof(T), boost::endian::order::little>(
@@ -180,7 +386,13 @@ namespace scale {
         return *this;
       }
       // decode value
-      v.emplace();
+      if constexpr (std::uses_allocator_v<
+                        mutableT,
+                        std::pmr::polymorphic_allocator<>>) {
+        v.emplace(makeValue<mutableT>());
+      } else {
+        v.emplace();
+      }
       return *this >> const_cast<mutableT &>(*v);  // NOLINT
     }
 
@@ -191,12 +403,34 @@ namespace scale {
      */
     ScaleDecoderStream &operator>>(CompactInteger &v);
 
+    /**
+     * @brief scale-decodes compact integer value to native unsigned integer
+     * @param v compact integer reference
+     * @return reference to stream
+     */
+    template <typename T>
+    ScaleDecoderStream &operator>>(Compact<T> &v) {
+      v.value = decodeCompact<T>();
+      return *this;
+    }
+
     /**
      * @brief scale-decodes to any static (fixed-size) collection
      * @param collection decoding collection to
      * @return reference to stream
      */
     ScaleDecoderStream &operator>>(StaticCollection auto &container) {
+      if (skipping_) {
+        skipItems<std::ranges::range_value_t<decltype(container)>>(
+            std::ranges::size(container));
+        return *this;
+      }
+      if constexpr (TriviallyEncodedCollection<
+                        std::decay_t<decltype(container)>>) {
+        nextBytes(asBytes(container));
+        return *this;
+      }
+      ensureStaticEncodedSize<std::decay_t<decltype(container)>>();
       for (auto &item : container) {
         *this >> item;
       }
@@ -210,17 +444,36 @@ namespace scale {
      * @return reference to stream
      */
     ScaleDecoderStream &operator>>(ResizeableCollection auto &collection) {
+      using value_type =
+          std::ranges::range_value_t<std::decay_t<decltype(collection)>>;
+
       auto item_count = decodeLength();
       if (item_count > collection.max_size()) {
-        raise(DecodeError::TOO_MANY_ITEMS);
+        fail(DecodeError::TOO_MANY_ITEMS);
+        return *this;
+      }
+
+      if constexpr (HasStaticEncodedSize<value_type>) {
+        // check all the items are present before allocating memory for them
+        if (not requireMore(item_count * static_encoded_size_v<value_type>)) {
+          return *this;
+        }
+      }
+
+      if (skipping_) {
+        skipItems<value_type>(item_count);
+        return *this;
       }
 
-      try {
-        collection.resize(item_count);
-      } catch (const std::bad_alloc &) {
-        raise(DecodeError::TOO_MANY_ITEMS);
+      if (not allocate([&] { collection.resize(item_count); })) {
+        return *this;
       }
 
+      if constexpr (TriviallyEncodedCollection<
+                        std::decay_t<decltype(collection)>>) {
+        nextBytes(asBytes(collection));
+        return *this;
+      }
       for (auto &item : collection) {
         *this >> item;
       }
@@ -235,13 +488,17 @@ namespace scale {
     ScaleDecoderStream &operator>>(std::vector<bool> &collection) {
       auto item_count = decodeLength();
       if (item_count > collection.max_size()) {
-        raise(DecodeError::TOO_MANY_ITEMS);
+        fail(DecodeError::TOO_MANY_ITEMS);
+        return *this;
       }
 
-      try {
-        collection.resize(item_count);
-      } catch (const std::bad_alloc &) {
-        raise(DecodeError::TOO_MANY_ITEMS);
+      if (skipping_) {
+        skipItems<bool>(item_count);
+        return *this;
+      }
+
+      if (not allocate([&] { collection.resize(item_count); })) {
+        return *this;
       }
 
       bool item;
@@ -262,6 +519,30 @@ namespace scale {
     /// Use manual decoding instead
     ScaleDecoderStream &operator>>(DynamicSpan auto &collection) = delete;
 
+    /**
+     * @brief scale-decodes byte collection as a view into the input data,
+     * allowed only for streams constructed with kBorrowInput
+     * @param v view to be set
+     * @return reference to stream
+     */
+    ScaleDecoderStream &operator>>(ConstSpanOfBytes &v) {
+      v = borrowBytes();
+      return *this;
+    }
+
+    /**
+     * @brief scale-decodes string as a view into the input data,
+     * allowed only for streams constructed with kBorrowInput
+     * @param v view to be set
+     * @return reference to stream
+     */
+    ScaleDecoderStream &operator>>(std::string_view &v) {
+      auto bytes = borrowBytes();
+      v = {reinterpret_cast<const char *>(bytes.data()),  // NOLINT
+           bytes.size()};
+      return *this;
+    }
+
     /**
      * @brief scale-decodes to sequential collection (which can be reserved
      * space first and push element by element back while decoding)
@@ -272,14 +553,19 @@ namespace scale {
 
       auto item_count = decodeLength();
       if (item_count > collection.max_size()) {
-        raise(DecodeError::TOO_MANY_ITEMS);
+        fail(DecodeError::TOO_MANY_ITEMS);
+        return *this;
+      }
+
+      if (skipping_) {
+        skipItems<std::ranges::range_value_t<decltype(collection)>>(
+            item_count);
+        return *this;
       }
 
       collection.clear();
-      try {
-        collection.reserve(item_count);
-      } catch (const std::bad_alloc &) {
-        raise(DecodeError::TOO_MANY_ITEMS);
+      if (not allocate([&] { collection.reserve(item_count); })) {
+        return *this;
       }
 
       for (size_type i = 0u; i < item_count; ++i) {
@@ -303,18 +589,22 @@ namespace scale {
 
       auto item_count = decodeLength();
       if (item_count > collection.max_size()) {
-        raise(DecodeError::TOO_MANY_ITEMS);
+        fail(DecodeError::TOO_MANY_ITEMS);
+        return *this;
+      }
+
+      if (skipping_) {
+        skipItems<value_type>(item_count);
+        return *this;
       }
 
-      value_type item;
+      auto item = makeItem(collection);
 
       collection.clear();
       for (size_type i = 0u; i < item_count; ++i) {
         *this >> item;
-        try {
-          collection.emplace(std::move(item));
-        } catch (const std::bad_alloc &) {
-          raise(DecodeError::TOO_MANY_ITEMS);
+        if (not allocate([&] { collection.emplace(std::move(item)); })) {
+          return *this;
         }
       }
       return *this;
@@ -325,8 +615,37 @@ namespace scale {
      * @param n Number of bytes to check
      * @return True if n more bytes are available and false otherwise
      */
-    bool hasMore(uint64_t n) const;
+    bool hasMore(uint64_t n) const {
+      // current index never exceeds the size, unlike the sum which may wrap
+      return n <= span_.size() - current_index_;
+    }
 
+    /**
+     * @brief fails with NOT_ENOUGH_DATA unless n more bytes are available,
+     * remembering the required size of data, so that
+     * decoding may be resumed when more data is available
+     * @param n number of bytes to be read
+     * @return true if n more bytes are available
+     */
+    bool requireMore(uint64_t n) {
+      if (hasMore(n)) {
+        return true;
+      }
+      if (not error_) {
+        required_size_ =
+            n > std::numeric_limits<SizeType>::max() - current_index_
+                ? std::numeric_limits<SizeType>::max()
+                : current_index_ + n;
+      }
+      fail(DecodeError::NOT_ENOUGH_DATA);
+      return false;
+    }
+
+    /**
+     * @brief advances current byte iterator over bytes already checked to be
+     * available
+     * @param size number of bytes to pass
+     */
     void seek(size_t size);
 
     /**
@@ -334,7 +653,19 @@ namespace scale {
      * advances current byte iterator by one
      * @return current byte
      */
-    uint8_t nextByte();
+    uint8_t nextByte() {
+      if (not requireMore(1)) {
+        return 0;
+      }
+      return span_[current_index_++];
+    }
+
+    /**
+     * @brief takes as many bytes from stream as fit the given buffer and
+     * advances current byte iterator accordingly
+     * @param out buffer to fill
+     */
+    void nextBytes(MutSpanOfBytes out);
 
     using ByteSpan = ConstSpanOfBytes;
     using SpanIterator = ByteSpan::iterator;
@@ -347,7 +678,145 @@ namespace scale {
       return current_index_;
     }
 
+    /**
+     * @return size of data, which was required by the last attempt to read
+     * past the end of the data, so decoding may proceed only with at least
+     * that much data
+     */
+    SizeType requiredSize() const {
+      // data is truncated on failure, so the original size is used
+      return std::max<SizeType>(required_size_, data_size_ + 1);
+    }
+
    private:
+    /**
+     * @return memory occupied by elements of the collection
+     */
+    static MutSpanOfBytes asBytes(
+        TriviallyEncodedCollection auto &collection) {
+      return {
+          reinterpret_cast<uint8_t *>(  // NOLINT
+              std::ranges::data(collection)),
+          std::ranges::size(collection)
+              * sizeof(std::ranges::range_value_t<decltype(collection)>)};
+    }
+
+    /**
+     * @brief checks at once that the stream contains enough data for a
+     * value of type T, if its encoded size is known at compile time, so
+     * decoding fails before any of its parts gets decoded
+     * @tparam T type of value to be decoded
+     */
+    template <typename T>
+    void ensureStaticEncodedSize() {
+      if constexpr (HasStaticEncodedSize<T>) {
+        // parts are not read from exhausted stream in case of failure
+        static_cast<void>(requireMore(static_encoded_size_v<T>));
+      }
+    }
+
+    /**
+     * @brief makes item to be decoded and inserted to the collection,
+     * using allocator of the collection, if any
+     * @param collection collection to insert the item to
+     * @return default-constructed item
+     */
+    template <typename Collection>
+    auto makeItem(const Collection &collection) const {
+      using value_type = typename Collection::value_type;
+      if constexpr (requires { collection.get_allocator(); }) {
+        return std::make_obj_using_allocator<value_type>(
+            collection.get_allocator());
+      } else {
+        return makeValue<value_type>();
+      }
+    }
+
+    /**
+     * @brief switches the stream to skip mode for its lifetime, so that
+     * collections are passed without being filled
+     */
+    class SkipModeGuard {
+     public:
+      explicit SkipModeGuard(ScaleDecoderStream &stream)
+          : stream_{stream}, previous_{std::exchange(stream.skipping_, true)} {}
+      SkipModeGuard(const SkipModeGuard &) = delete;
+      SkipModeGuard &operator=(const SkipModeGuard &) = delete;
+      ~SkipModeGuard() {
+        stream_.skipping_ = previous_;
+      }
+
+     private:
+      ScaleDecoderStream &stream_;
+      bool previous_;
+    };
+
+    /**
+     * @brief runs operation allocating memory for collection items, fails
+     * with TOO_MANY_ITEMS if there is not enough memory
+     * @param op allocating operation
+     * @return true if succeeded
+     */
+    bool allocate(const auto &op) {
+      BOOST_TRY {
+        op();
+      }
+      BOOST_CATCH(const std::bad_alloc &) {
+        fail(DecodeError::TOO_MANY_ITEMS);
+        return false;
+      }
+      BOOST_CATCH_END
+      return true;
+    }
+
+    /**
+     * @brief advances current byte iterator by n bytes
+     * @param n number of bytes to skip
+     */
+    void skipBytes(size_t n) {
+      if (requireMore(n)) {
+        current_index_ += n;
+      }
+    }
+
+    /**
+     * @brief skips given number of encoded items of collection
+     * @tparam Item type of collection item
+     * @param item_count number of items
+     */
+    template <typename Item>
+    void skipItems(size_t item_count) {
+      using mutableItem = std::remove_const_t<Item>;
+      if constexpr (UncheckedEncoding<mutableItem>) {
+        constexpr auto item_size = static_encoded_size_v<mutableItem>;
+        if (item_count > std::numeric_limits<size_t>::max() / item_size) {
+          requireMore(std::numeric_limits<uint64_t>::max());
+          return;
+        }
+        skipBytes(item_count * item_size);
+      } else {
+        // placeholder is reused, skipped collections inside it stay empty
+        mutableItem placeholder{};
+        for (size_t i = 0u; i < item_count; ++i) {
+          *this >> placeholder;
+        }
+      }
+    }
+
+    /**
+     * @brief scale-decodes compact integer without wide integer arithmetic
+     * @return decoded value, fails with TOO_MANY_ITEMS if it exceeds 64 bits
+     */
+    uint64_t decodeCompactUint64();
+
+    /**
+     * @brief decodes length of byte collection and takes its bytes as a view
+     * into the input data, fails with BORROWING_NOT_ALLOWED unless the stream
+     * is borrowing
+     * @return view of the collection bytes
+     */
+    ConstSpanOfBytes borrowBytes();
+
     bool decodeBool();
     /**
      * @brief special case of optional values as described in specification
@@ -364,23 +833,61 @@ namespace scale {
       }
     }
 
+    /**
+     * @brief decodes value of variant alternative by a table of functions,
+     * one for each alternative, indexed by the alternative
+     * @param v variant to decode to
+     * @param index index of the alternative, which is checked to be valid
+     */
+    template <class Variant, size_t... I>
+    void decodeVariant(Variant &v, size_t index, std::index_sequence<I...>) {
+      static_assert(sizeof...(I) <= 256, "Type index must fit one byte");
+      using Decoder = void (*)(ScaleDecoderStream &, Variant &);
+      static constexpr std::array<Decoder, sizeof...(I)> kDecoders{
+          &decodeAlternative<I, Variant>...};
+      kDecoders[index](*this, v);
+    }
+
+    template <size_t I, class Variant>
+    static void decodeAlternative(ScaleDecoderStream &s, Variant &v) {
+      s >> s.emplaceAlternative<I>(v);
+    }
+
+    /**
+     * @brief makes the alternative of variant in place to be decoded to,
+     * so the decoded value is not moved
+     * @return reference to the alternative
+     */
     template <size_t I, class... Ts>
-    void tryDecodeAsOneOfVariant(boost::variant<Ts...> &v, size_t i) {
+    auto &emplaceAlternative(boost::variant<Ts...> &v) const {
       using T = std::remove_const_t<std::tuple_element_t<I, std::tuple<Ts...>>>;
       static_assert(std::is_default_constructible_v<T>);
-      if (I == i) {
-        T val;
-        *this >> val;
-        v = std::forward<T>(val);
-        return;
-      }
-      if constexpr (sizeof...(Ts) > I + 1) {
-        tryDecodeAsOneOfVariant<I + 1>(v, i);
+      v = makeValue<T>();
+      return boost::relaxed_get<T>(v);
+    }
+
+    template <size_t I, class... Ts>
+    auto &emplaceAlternative(std::variant<Ts...> &v) const {
+      using T = std::variant_alternative_t<I, std::variant<Ts...>>;
+      static_assert(std::is_default_constructible_v<T>);
+      if constexpr (std::uses_allocator_v<T,
+                                          std::pmr::polymorphic_allocator<>>) {
+        return v.template emplace<I>(makeValue<T>());
+      } else {
+        return v.template emplace<I>();
       }
     }
 
     ByteSpan span_;
+    // size of data before it is truncated on failure
+    SizeType data_size_;
     SizeType current_index_;
+    bool borrowing_;
+    bool skipping_;
+    SizeType required_size_ = 0;
+    std::error_code error_;
+    bool throw_on_error_ = kThrowOnErrorByDefault;
+    std::pmr::memory_resource *memory_resource_ = nullptr;
   };
 
 }  // namespace scale
@@ -0,0 +1,56 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <scale/scale_encoder_stream.hpp>
+
+namespace scale {
+
+  /**
+   * @class ScaleEncodeCounter designed to calculate size of scale-encoded
+   * data without encoding it.
+   * Items of collections having statically known encoded size are not
+   * visited, so the size of such collections is computed in O(1).
+   */
+  class ScaleEncodeCounter
+      : public ScaleEncoderStreamBase<ScaleEncodeCounter> {
+   public:
+    static constexpr auto is_counting_stream = true;
+
+    ScaleEncodeCounter() = default;
+
+    /**
+     * Get amount of data which would be written by encoder stream
+     * @return size in bytes
+     */
+    size_t size() const {
+      return bytes_counted_;
+    }
+
+   protected:
+    friend class ScaleEncoderStreamBase<ScaleEncodeCounter>;
+
+    ScaleEncodeCounter &putByte(uint8_t) {
+      ++bytes_counted_;
+      return *this;
+    }
+
+    ScaleEncodeCounter &putBytes(ConstSpanOfBytes v) {
+      bytes_counted_ += v.size();
+      return *this;
+    }
+
+    ScaleEncodeCounter &skipBytes(size_t n) {
+      bytes_counted_ += n;
+      return *this;
+    }
+
+   private:
+    size_t bytes_counted_ = 0;
+  };
+
+}  // namespace scale
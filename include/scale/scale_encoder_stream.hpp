@@ -6,64 +6,105 @@
 
 #pragma once
 
-#include <deque>
+#include <array>
 #include <memory>
 #include <optional>
+#include <utility>
+#include <variant>
+#include <vector>
 
 #include <boost/variant.hpp>
 
 #include <scale/bitvec.hpp>
+#include <scale/detail/compact_integer.hpp>
 #include <scale/detail/fixed_width_integer.hpp>
 #include <scale/scale_error.hpp>
+#include <scale/static_encoded_size.hpp>
 #include <scale/types.hpp>
 
 namespace scale {
 
   /**
-   * @class ScaleEncoderStream designed to scale-encode data to stream
+   * @class ScaleEncoderStreamBase implements scale-encoding of data, while
+   * storing of encoded bytes is up to derived stream.
+   * @tparam Derived encoder stream type, which has to provide
+   * `Derived &putByte(uint8_t)` and `Derived &putBytes(ConstSpanOfBytes)`
    */
-  class ScaleEncoderStream {
+  template <class Derived>
+  class ScaleEncoderStreamBase {
    public:
     // special tag to differentiate encoding streams from others
     static constexpr auto is_encoder_stream = true;
 
-    ScaleEncoderStream();
+    // special tag of streams, which only count size of encoded data, such
+    // streams have to provide `Derived &skipBytes(size_t)`
+    static constexpr auto is_counting_stream = false;
 
     /**
-     * Stream initialization
-     * @param drop_data - when true will only count encoded data size while
-     * omitting the data itself
+     * @brief sets whether the stream raises errors as exceptions, which is
+     * the default unless exceptions are disabled, or only records them
+     * @param enable true to raise errors
      */
-    explicit ScaleEncoderStream(bool drop_data);
+    void setThrowOnError(bool enable) {
+      throw_on_error_ = enable;
+    }
+
+    bool throwsOnError() const {
+      return throw_on_error_;
+    }
 
     /**
-     * @return vector of bytes containing encoded data
+     * @return the first error occurred during encoding, if any
      */
-    std::vector<uint8_t> to_vector() const;
+    const std::error_code &error() const {
+      return error_;
+    }
 
     /**
-     * Get amount of encoded data written to the stream
-     * @return size in bytes
+     * @brief reports encoding error: raises it if the stream throws on
+     * errors, otherwise records the first one, while encoding proceeds
+     * @param error error to report
+     * @return reference to stream
      */
-    size_t size() const;
+    Derived &fail(std::error_code error) {
+#ifndef BOOST_NO_EXCEPTIONS
+      if (throw_on_error_) {
+        raise(error);
+      }
+#endif
+      if (not error_) {
+        error_ = error;
+      }
+      return derived();
+    }
 
     /**
      * @brief scale-encodes range
      * @param collection range to encode
      * @return reference to stream
      */
-    ScaleEncoderStream &operator<<(const DynamicCollection auto &collection) {
+    Derived &operator<<(const DynamicCollection auto &collection) {
       return encodeDynamicCollection(collection);
     }
 
-    ScaleEncoderStream &operator<<(const StaticCollection auto &collection) {
+    Derived &operator<<(const StaticCollection auto &collection) {
       return encodeStaticCollection(collection);
     }
 
+    /**
+     * @brief writes bytes of EncodeOpaqueValue as is, at once
+     */
+    Derived &operator<<(const EncodeOpaqueValue &value) {
+      return derived().putBytes(value.v);
+    }
+
     /**
      * @brief scale-encodes BitVec
      */
-    ScaleEncoderStream &operator<<(const BitVec &v);
+    Derived &operator<<(const BitVec &v) {
+      derived() << Compact<size_t>{v.size()};
+      return derived().putBytes(v.bytes());
+    }
 
     /**
      * @brief scale-encodes pair of values
@@ -73,8 +114,12 @@ namespace scale {
      * @return reference to stream
      */
     template <class F, class S>
-    ScaleEncoderStream &operator<<(const std::pair<F, S> &p) {
-      return *this << p.first << p.second;
+    Derived &operator<<(const std::pair<F, S> &p) {
+      if constexpr (Derived::is_counting_stream
+                    and HasStaticEncodedSize<std::pair<F, S>>) {
+        return derived().skipBytes(static_encoded_size_v<std::pair<F, S>>);
+      }
+      return derived() << p.first << p.second;
     }
 
     /**
@@ -84,11 +129,15 @@ namespace scale {
      * @return reference to stream
      */
     template <class... Ts>
-    ScaleEncoderStream &operator<<(const std::tuple<Ts...> &v) {
+    Derived &operator<<(const std::tuple<Ts...> &v) {
+      if constexpr (Derived::is_counting_stream
+                    and HasStaticEncodedSize<std::tuple<Ts...>>) {
+        return derived().skipBytes(static_encoded_size_v<std::tuple<Ts...>>);
+      }
       if constexpr (sizeof...(Ts) > 0) {
         encodeElementOfTuple<0>(v);
       }
-      return *this;
+      return derived();
     }
 
     /**
@@ -98,9 +147,30 @@ namespace scale {
      * @return reference to stream
      */
     template <class... T>
-    ScaleEncoderStream &operator<<(const boost::variant<T...> &v) {
-      tryEncodeAsOneOfVariant<0>(v);
-      return *this;
+    Derived &operator<<(const boost::variant<T...> &v) {
+      return encodeVariant(
+          v, static_cast<size_t>(v.which()), std::index_sequence_for<T...>{});
+    }
+
+    /**
+     * @brief scale-encodes std::variant value the same way as boost::variant
+     * @tparam T type list
+     * @param v value to encode
+     * @return reference to stream
+     */
+    template <class... T>
+    Derived &operator<<(const std::variant<T...> &v) {
+      if (v.valueless_by_exception()) {
+        return fail(EncodeError::VALUELESS_VARIANT);
+      }
+      return encodeVariant(v, v.index(), std::index_sequence_for<T...>{});
+    }
+
+    /**
+     * @brief scale-encodes empty alternative of std::variant as nothing
+     */
+    Derived &operator<<(std::monostate) {
+      return derived();
     }
 
     /**
@@ -110,11 +180,11 @@ namespace scale {
      * @return reference to stream
      */
     template <class T>
-    ScaleEncoderStream &operator<<(const std::shared_ptr<T> &v) {
+    Derived &operator<<(const std::shared_ptr<T> &v) {
       if (v == nullptr) {
-        raise(EncodeError::DEREF_NULLPOINTER);
+        return fail(EncodeError::DEREF_NULLPOINTER);
       }
-      return *this << *v;
+      return derived() << *v;
     }
 
     /**
@@ -124,11 +194,11 @@ namespace scale {
      * @return reference to stream
      */
     template <class T>
-    ScaleEncoderStream &operator<<(const std::unique_ptr<T> &v) {
+    Derived &operator<<(const std::unique_ptr<T> &v) {
       if (v == nullptr) {
-        raise(EncodeError::DEREF_NULLPOINTER);
+        return fail(EncodeError::DEREF_NULLPOINTER);
       }
-      return *this << *v;
+      return derived() << *v;
     }
 
     /**
@@ -138,7 +208,7 @@ namespace scale {
      * @return reference to stream
      */
     template <class T>
-    ScaleEncoderStream &operator<<(const std::optional<T> &v) {
+    Derived &operator<<(const std::optional<T> &v) {
       // optional bool is a special case of optional values
       // it should be encoded using one byte instead of two
       // as described in specification
@@ -146,9 +216,9 @@ namespace scale {
         return encodeOptionalBool(v);
       }
       if (!v.has_value()) {
-        return putByte(0u);
+        return derived().putByte(0u);
       }
-      return putByte(1u) << *v;
+      return derived().putByte(1u) << *v;
     }
 
     /**
@@ -156,8 +226,8 @@ namespace scale {
      * @param v - std::nullopt only
      * @return reference to stream
      */
-    ScaleEncoderStream &operator<<(const std::nullopt_t &) {
-      return putByte(0u);
+    Derived &operator<<(const std::nullopt_t &) {
+      return derived().putByte(0u);
     }
 
     /**
@@ -167,8 +237,8 @@ namespace scale {
      * @return reference to stream;
      */
     template <class T>
-    ScaleEncoderStream &operator<<(const std::reference_wrapper<T> &v) {
-      return *this << static_cast<const T &>(v);
+    Derived &operator<<(const std::reference_wrapper<T> &v) {
+      return derived() << static_cast<const T &>(v);
     }
 
     /**
@@ -176,7 +246,7 @@ namespace scale {
      * @param sv string_view item
      * @return reference to stream
      */
-    ScaleEncoderStream &operator<<(std::string_view sv) {
+    Derived &operator<<(std::string_view sv) {
       return encodeDynamicCollection(sv);
     }
 
@@ -185,12 +255,15 @@ namespace scale {
      * @param v vector of bool
      * @return reference to stream
      */
-    ScaleEncoderStream &operator<<(const std::vector<bool> &v) {
-      *this << CompactInteger{v.size()};
+    Derived &operator<<(const std::vector<bool> &v) {
+      derived() << Compact<size_t>{v.size()};
+      if constexpr (Derived::is_counting_stream) {
+        return derived().skipBytes(v.size());
+      }
       for (bool el : v) {
-        *this << el;
+        derived() << el;
       }
-      return *this;
+      return derived();
     }
 
     /**
@@ -202,20 +275,22 @@ namespace scale {
     template <typename T,
               typename I = std::decay_t<T>,
               typename = std::enable_if_t<std::is_integral_v<I>>>
-    ScaleEncoderStream &operator<<(T &&v) {
+    Derived &operator<<(T &&v) {
       // encode bool
       if constexpr (std::is_same_v<I, bool>) {
         uint8_t byte = (v ? 1u : 0u);
-        return putByte(byte);
+        return derived().putByte(byte);
       }
       // put byte
       if constexpr (sizeof(T) == 1u) {
         // to avoid infinite recursion
-        return putByte(static_cast<uint8_t>(v));
+        return derived().putByte(static_cast<uint8_t>(v));
       }
       // encode any other integer
-      detail::encodeInteger<I>(v, *this);
-      return *this;
+      std::array<uint8_t, sizeof(I)> bytes;
+      boost::endian::endian_store<I, sizeof(I), boost::endian::order::little>(
+          bytes.data(), v);
+      return derived().putBytes(bytes);
     }
 
     /**
@@ -223,27 +298,83 @@ namespace scale {
      * @param v value to encode
      * @return reference to stream
      */
-    ScaleEncoderStream &operator<<(const CompactInteger &v);
+    Derived &operator<<(const CompactInteger &v) {
+      if constexpr (Derived::is_counting_stream) {
+        const auto size = compact::compactLen(v);
+        if (size > detail::kMaxCompactIntegerSize) {
+          return fail(EncodeError::COMPACT_INTEGER_TOO_BIG);
+        }
+        return derived().skipBytes(size);
+      }
+      detail::CompactIntegerBuffer buffer;
+      auto size = detail::encodeCompactInteger(v, buffer);
+      if (size.has_error()) {
+        return fail(size.error());
+      }
+      return derived().putBytes({buffer.data(), size.value()});
+    }
+
+    /**
+     * @brief scale-encodes native unsigned integer as compact integer
+     * @param v value to encode
+     * @return reference to stream
+     */
+    template <typename T>
+    Derived &operator<<(const Compact<T> &v) {
+      if constexpr (Derived::is_counting_stream) {
+        return derived().skipBytes(compact::compactLen(v.value));
+      }
+      detail::NativeCompactBuffer buffer;
+      auto size = detail::encodeCompactInteger(v.value, buffer);
+      return derived().putBytes({buffer.data(), size});
+    }
 
    protected:
+    Derived &derived() {
+      return static_cast<Derived &>(*this);
+    }
+
     template <size_t I, class... Ts>
     void encodeElementOfTuple(const std::tuple<Ts...> &v) {
-      *this << std::get<I>(v);
+      derived() << std::get<I>(v);
       if constexpr (sizeof...(Ts) > I + 1) {
         encodeElementOfTuple<I + 1>(v);
       }
     }
 
-    template <uint8_t I, class... Ts>
-    void tryEncodeAsOneOfVariant(const boost::variant<Ts...> &v) {
+    /**
+     * @brief encodes index and value of variant alternative by a table of
+     * functions, one for each alternative, indexed by the alternative
+     * @param v variant to encode
+     * @param index index of the alternative held by the variant
+     * @return reference to stream
+     */
+    template <class Variant, size_t... I>
+    Derived &encodeVariant(const Variant &v,
+                           size_t index,
+                           std::index_sequence<I...>) {
+      static_assert(sizeof...(I) <= 256, "Type index must fit one byte");
+      using Encoder = void (*)(Derived &, const Variant &);
+      static constexpr std::array<Encoder, sizeof...(I)> kEncoders{
+          &encodeAlternative<I, Variant>...};
+      kEncoders[index](derived(), v);
+      return derived();
+    }
+
+    template <size_t I, class Variant>
+    static void encodeAlternative(Derived &s, const Variant &v) {
+      s << static_cast<uint8_t>(I) << getAlternative<I>(v);
+    }
+
+    template <size_t I, class... Ts>
+    static const auto &getAlternative(const boost::variant<Ts...> &v) {
       using T = std::tuple_element_t<I, std::tuple<Ts...>>;
-      if (v.type() == typeid(T)) {
-        *this << I << boost::get<T>(v);
-        return;
-      }
-      if constexpr (sizeof...(Ts) > I + 1) {
-        tryEncodeAsOneOfVariant<I + 1>(v);
-      }
+      return boost::relaxed_get<T>(v);
+    }
+
+    template <size_t I, class... Ts>
+    static const auto &getAlternative(const std::variant<Ts...> &v) {
+      return *std::get_if<I>(&v);
     }
 
     /**
@@ -251,13 +382,10 @@ namespace scale {
      * @param collection encoding collection
      * @return reference to stream
      */
-    ScaleEncoderStream &encodeDynamicCollection(
+    Derived &encodeDynamicCollection(
         const std::ranges::sized_range auto &collection) {
-      *this << CompactInteger{collection.size()};
-      for (const auto &item : collection) {
-        *this << item;
-      }
-      return *this;
+      derived() << Compact<size_t>{collection.size()};
+      return encodeItems(collection);
     }
 
     /**
@@ -265,26 +393,134 @@ namespace scale {
      * @param collection encoding collection
      * @return reference to stream
      */
-    ScaleEncoderStream &encodeStaticCollection(
-        const StaticCollection auto &collection) {
-      for (const auto &item : collection) {
-        *this << item;
+    Derived &encodeStaticCollection(const StaticCollection auto &collection) {
+      return encodeItems(collection);
+    }
+
+   private:
+    /**
+     * @brief scale-encodes items of collection one after another
+     * @param collection encoding collection
+     * @return reference to stream
+     */
+    Derived &encodeItems(const std::ranges::sized_range auto &collection) {
+      using Collection = std::decay_t<decltype(collection)>;
+      using Item = std::ranges::range_value_t<Collection>;
+      if constexpr (TriviallyEncodedCollection<Collection>) {
+        return derived().putBytes(asBytes(collection));
+      } else if constexpr (Derived::is_counting_stream
+                           and HasStaticEncodedSize<Item>) {
+        // no need to visit items having the same encoded size
+        return derived().skipBytes(std::ranges::size(collection)
+                                   * static_encoded_size_v<Item>);
+      } else {
+        for (const auto &item : collection) {
+          derived() << item;
+        }
+        return derived();
       }
-      return *this;
     }
 
+    /**
+     * @return memory occupied by elements of the collection
+     */
+    static ConstSpanOfBytes asBytes(
+        const TriviallyEncodedCollection auto &collection) {
+      return {
+          reinterpret_cast<const uint8_t *>(  // NOLINT
+              std::ranges::data(collection)),
+          std::ranges::size(collection)
+              * sizeof(std::ranges::range_value_t<decltype(collection)>)};
+    }
+
+    Derived &encodeOptionalBool(const std::optional<bool> &v) {
+      auto result = OptionalBool::OPT_TRUE;
+
+      if (!v.has_value()) {
+        result = OptionalBool::NONE;
+      } else if (!*v) {
+        result = OptionalBool::OPT_FALSE;
+      }
+
+      return derived().putByte(static_cast<uint8_t>(result));
+    }
+
+    std::error_code error_;
+    bool throw_on_error_ = kThrowOnErrorByDefault;
+  };
+
+  /**
+   * @class ScaleEncoderStream designed to scale-encode data to stream
+   */
+  class ScaleEncoderStream
+      : public ScaleEncoderStreamBase<ScaleEncoderStream> {
+   public:
+    ScaleEncoderStream();
+
+    /**
+     * Stream initialization
+     * @param drop_data - when true will only count encoded data size while
+     * omitting the data itself
+     * @note ScaleEncodeCounter is a faster way to count encoded data size
+     */
+    explicit ScaleEncoderStream(bool drop_data);
+
+    /**
+     * @return vector of bytes containing encoded data
+     */
+    std::vector<uint8_t> to_vector() const;
+
+    /**
+     * Moves encoded data out of the stream without copying it,
+     * the stream becomes empty afterwards
+     * @return vector of bytes containing encoded data
+     */
+    std::vector<uint8_t> take();
+
+    /**
+     * Preallocates buffer to fit at least given amount of encoded data
+     * @param size expected size in bytes
+     */
+    void reserve(size_t size);
+
+    /**
+     * Get amount of encoded data written to the stream
+     * @return size in bytes
+     */
+    size_t size() const;
+
+   protected:
+    friend class ScaleEncoderStreamBase<ScaleEncoderStream>;
+
     /**
      * @brief puts a byte to buffer
      * @param v byte value
      * @return reference to stream
      */
-    ScaleEncoderStream &putByte(uint8_t v);
+    ScaleEncoderStream &putByte(uint8_t v) {
+      ++bytes_written_;
+      if (not drop_data_) {
+        stream_.push_back(v);
+      }
+      return *this;
+    }
 
-   private:
-    ScaleEncoderStream &encodeOptionalBool(const std::optional<bool> &v);
+    /**
+     * @brief puts bytes to buffer
+     * @param v bytes
+     * @return reference to stream
+     */
+    ScaleEncoderStream &putBytes(ConstSpanOfBytes v) {
+      bytes_written_ += v.size();
+      if (not drop_data_) {
+        stream_.insert(stream_.end(), v.begin(), v.end());
+      }
+      return *this;
+    }
 
+   private:
     const bool drop_data_;
-    std::deque<uint8_t> stream_;
+    std::vector<uint8_t> stream_;
     size_t bytes_written_;
   };
 
@@ -17,17 +17,20 @@ namespace scale {
     COMPACT_INTEGER_TOO_BIG = 1,  ///< compact integer can't be more than 2**536
     NEGATIVE_COMPACT_INTEGER,     ///< cannot compact-encode negative integers
     DEREF_NULLPOINTER,            ///< dereferencing a null pointer
+    BUFFER_TOO_SMALL,             ///< encoded data does not fit the buffer
+    VALUELESS_VARIANT,            ///< variant holds no value
   };
 
   /**
    * @brief DecoderError enum provides codes of errors for Decoder methods
    */
   enum class DecodeError {
-    NOT_ENOUGH_DATA = 1,  ///< not enough data to decode value
-    UNEXPECTED_VALUE,     ///< unexpected value
-    TOO_MANY_ITEMS,       ///< too many items, cannot address them in memory
-    WRONG_TYPE_INDEX,     ///< wrong type index, cannot decode variant
-    INVALID_ENUM_VALUE    ///< enum value which doesn't belong to the enum
+    NOT_ENOUGH_DATA = 1,    ///< not enough data to decode value
+    UNEXPECTED_VALUE,       ///< unexpected value
+    TOO_MANY_ITEMS,         ///< too many items, cannot address them in memory
+    WRONG_TYPE_INDEX,       ///< wrong type index, cannot decode variant
+    INVALID_ENUM_VALUE,     ///< enum value which doesn't belong to the enum
+    BORROWING_NOT_ALLOWED,  ///< views are decoded by borrowing streams only
   };
 
 }  // namespace scale
@@ -0,0 +1,102 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <iosfwd>
+#include <optional>
+#include <vector>
+
+#include <scale/incremental_decoder.hpp>
+
+namespace scale {
+
+  /**
+   * @class ByteSource reads data from a file descriptor or std::istream
+   */
+  class ByteSource {
+   public:
+    /**
+     * @param fd file descriptor to read from, it is not closed by the source
+     */
+    explicit ByteSource(int fd) : fd_{fd} {}
+
+    /**
+     * @param in stream to read from, must outlive the source
+     */
+    explicit ByteSource(std::istream &in) : in_{&in} {}
+
+    /**
+     * @brief reads available data, waiting for at least one byte
+     * @param out buffer to fill
+     * @return number of bytes read, 0 at the end of data
+     */
+    outcome::result<size_t> read(MutSpanOfBytes out);
+
+   private:
+    int fd_ = -1;
+    std::istream *in_ = nullptr;
+  };
+
+  /**
+   * @class ScaleReader decodes consecutive values of type T from a file
+   * descriptor or std::istream, which data is read in chunks of fixed size,
+   * so decoding proceeds while data is read and memory taken is bounded by
+   * the size of encoded value and a chunk.
+   * Values must own their data, see IncrementalDecoder.
+   * @tparam T type of decoded values
+   */
+  template <typename T>
+  class ScaleReader {
+   public:
+    /// Default size of chunk read at once
+    static constexpr size_t kDefaultChunkSize = 64 * 1024;
+
+    /**
+     * @param source source of encoded values
+     * @param chunk_size size of chunk read at once
+     */
+    explicit ScaleReader(ByteSource source,
+                         size_t chunk_size = kDefaultChunkSize)
+        : source_{source}, chunk_(std::max<size_t>(chunk_size, 1)) {}
+
+    /**
+     * @brief decodes next value, reading as much data as it requires
+     * @return value, nothing if data ends before the value, or error if
+     * data ends in the middle of it
+     */
+    outcome::result<std::optional<T>> next() {
+      ConstSpanOfBytes data;
+      while (true) {
+#ifdef _WIN32
+        size_t missing;
+#endif
+        OUTCOME_TRY(missing, decoder_.feed(data));
+        if (missing == 0) {
+          return std::optional<T>{decoder_.take()};
+        }
+#ifdef _WIN32
+        size_t size;
+#endif
+        OUTCOME_TRY(size, source_.read(chunk_));
+        if (size == 0) {
+          if (decoder_.remaining().empty()) {
+            return std::optional<T>{};
+          }
+          return DecodeError::NOT_ENOUGH_DATA;
+        }
+        data = ConstSpanOfBytes{chunk_}.first(size);
+      }
+    }
+
+   private:
+    ByteSource source_;
+    std::vector<uint8_t> chunk_;
+    IncrementalDecoder<T> decoder_;
+  };
+
+}  // namespace scale
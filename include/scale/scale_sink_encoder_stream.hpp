@@ -0,0 +1,126 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <iosfwd>
+#include <vector>
+
+#include <scale/scale_encoder_stream.hpp>
+
+namespace scale {
+
+  /**
+   * @class ScaleSinkEncoderStream designed to scale-encode data directly to
+   * a file descriptor or std::ostream through a buffer of fixed size, so
+   * encoding of arbitrarily large data takes constant memory.
+   * Buffered data is written when the buffer gets full, when encoded bytes
+   * do not fit it, or on flush(). Failure of writing is reported as the
+   * stream error, the rest of encoded data is dropped then, while its size
+   * is still counted.
+   * File descriptors are written with writev() on POSIX systems and with
+   * _write() of the C runtime on Windows.
+   */
+  class ScaleSinkEncoderStream
+      : public ScaleEncoderStreamBase<ScaleSinkEncoderStream> {
+   public:
+    /// Default size of buffer
+    static constexpr size_t kDefaultBufferSize = 64 * 1024;
+
+    /**
+     * Stream initialization
+     * @param fd file descriptor to write encoded data to, it is not closed
+     * by the stream
+     * @param buffer_size size of buffer
+     */
+    explicit ScaleSinkEncoderStream(int fd,
+                                    size_t buffer_size = kDefaultBufferSize);
+
+    /**
+     * Stream initialization
+     * @param out stream to write encoded data to, must outlive the stream
+     * @param buffer_size size of buffer
+     */
+    explicit ScaleSinkEncoderStream(std::ostream &out,
+                                    size_t buffer_size = kDefaultBufferSize);
+
+    ScaleSinkEncoderStream(const ScaleSinkEncoderStream &) = delete;
+    ScaleSinkEncoderStream &operator=(const ScaleSinkEncoderStream &) =
+        delete;
+
+    /**
+     * Writes buffered data, errors are ignored, so flush() has to be called
+     * to find out whether all the data is written
+     */
+    ~ScaleSinkEncoderStream();
+
+    /**
+     * Get amount of encoded data, including the data which is buffered
+     * and not written yet, same as ScaleEncoderStream::size()
+     * @return size in bytes
+     */
+    size_t size() const {
+      return bytes_written_;
+    }
+
+    /**
+     * @brief writes buffered data and flushes std::ostream, so that the
+     * data reaches its sink
+     * @return reference to stream
+     */
+    ScaleSinkEncoderStream &flush();
+
+   protected:
+    friend class ScaleEncoderStreamBase<ScaleSinkEncoderStream>;
+
+    /**
+     * @brief puts a byte to buffer, writing the buffer if it is full
+     * @param v byte value
+     * @return reference to stream
+     */
+    ScaleSinkEncoderStream &putByte(uint8_t v) {
+      if (buffered_ == buffer_.size()) {
+        write({});
+      }
+      buffer_[buffered_++] = v;
+      ++bytes_written_;
+      return *this;
+    }
+
+    /**
+     * @brief puts bytes to buffer, bytes which do not fit it are written
+     * together with the buffer without copying
+     * @param v bytes
+     * @return reference to stream
+     */
+    ScaleSinkEncoderStream &putBytes(ConstSpanOfBytes v) {
+      bytes_written_ += v.size();
+      if (v.size() <= buffer_.size() - buffered_) {
+        std::copy(v.begin(), v.end(), buffer_.begin() + buffered_);
+        buffered_ += v.size();
+      } else {
+        write(v);
+      }
+      return *this;
+    }
+
+   private:
+    /**
+     * @brief writes buffered data followed by given bytes, buffer becomes
+     * empty even in case of failure
+     * @param tail bytes to write after buffered data
+     */
+    void write(ConstSpanOfBytes tail);
+
+    int fd_ = -1;
+    std::ostream *out_ = nullptr;
+    std::vector<uint8_t> buffer_;
+    size_t buffered_ = 0;
+    size_t bytes_written_ = 0;
+  };
+
+}  // namespace scale
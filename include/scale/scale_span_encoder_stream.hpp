@@ -0,0 +1,89 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <algorithm>
+
+#include <scale/scale_encoder_stream.hpp>
+
+namespace scale {
+
+  /**
+   * @class ScaleSpanEncoderStream designed to scale-encode data to a buffer
+   * provided by caller, without any heap allocation.
+   * When encoded data does not fit the buffer, the stream keeps counting its
+   * size, so the caller is able to find out how big the buffer should be.
+   */
+  class ScaleSpanEncoderStream
+      : public ScaleEncoderStreamBase<ScaleSpanEncoderStream> {
+   public:
+    /**
+     * Stream initialization
+     * @param buffer - memory to write encoded data to
+     */
+    explicit ScaleSpanEncoderStream(MutSpanOfBytes buffer)
+        : buffer_{buffer}, bytes_written_{0} {}
+
+    /**
+     * Get amount of encoded data written to the stream, including the data
+     * which did not fit the buffer
+     * @return size in bytes
+     */
+    size_t size() const {
+      return bytes_written_;
+    }
+
+    /**
+     * @return true if encoded data did not fit the buffer, its content is
+     * unspecified in this case
+     */
+    bool overflowed() const {
+      return bytes_written_ > buffer_.size();
+    }
+
+    /**
+     * @return part of the buffer filled with encoded data
+     */
+    MutSpanOfBytes data() const {
+      return buffer_.first(std::min(bytes_written_, buffer_.size()));
+    }
+
+   protected:
+    friend class ScaleEncoderStreamBase<ScaleSpanEncoderStream>;
+
+    /**
+     * @brief puts a byte to buffer if there is space left
+     * @param v byte value
+     * @return reference to stream
+     */
+    ScaleSpanEncoderStream &putByte(uint8_t v) {
+      if (bytes_written_ < buffer_.size()) {
+        buffer_[bytes_written_] = v;
+      }
+      ++bytes_written_;
+      return *this;
+    }
+
+    /**
+     * @brief puts bytes to buffer if there is space left
+     * @param v bytes
+     * @return reference to stream
+     */
+    ScaleSpanEncoderStream &putBytes(ConstSpanOfBytes v) {
+      if (bytes_written_ + v.size() <= buffer_.size()) {
+        std::copy(v.begin(), v.end(), buffer_.begin() + bytes_written_);
+      }
+      bytes_written_ += v.size();
+      return *this;
+    }
+
+   private:
+    MutSpanOfBytes buffer_;
+    size_t bytes_written_;
+  };
+
+}  // namespace scale
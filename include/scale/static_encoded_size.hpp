@@ -0,0 +1,101 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace scale {
+
+  /**
+   * Size of scale-encoded value of type T, if it is known at compile time.
+   * Defined for integers, enums, and std::array, std::pair and std::tuple of
+   * types with static encoded size.
+   * Specialize it for custom types having fixed encoded size, specialization
+   * must provide `static constexpr size_t value`.
+   * @note keep specializations for enums with custom encoding consistent with
+   * their encoder
+   * @tparam T type to be encoded
+   */
+  template <typename T>
+  struct static_encoded_size {};
+
+  template <typename T>
+    requires std::is_integral_v<T>
+  struct static_encoded_size<T> : std::integral_constant<size_t, sizeof(T)> {
+  };
+
+  template <typename T>
+    requires std::is_enum_v<T>
+  struct static_encoded_size<T>
+      : static_encoded_size<std::underlying_type_t<T>> {};
+
+  /// Types, which size of scale-encoded value is known at compile time
+  template <typename T>
+  concept HasStaticEncodedSize =
+      requires { static_encoded_size<std::remove_cv_t<T>>::value; };
+
+  template <HasStaticEncodedSize T>
+  constexpr size_t static_encoded_size_v =
+      static_encoded_size<std::remove_cv_t<T>>::value;
+
+  template <HasStaticEncodedSize T, size_t N>
+  struct static_encoded_size<std::array<T, N>>
+      : std::integral_constant<size_t, N * static_encoded_size_v<T>> {};
+
+  template <HasStaticEncodedSize F, HasStaticEncodedSize S>
+  struct static_encoded_size<std::pair<F, S>>
+      : std::integral_constant<size_t,
+                               static_encoded_size_v<F>
+                                   + static_encoded_size_v<S>> {};
+
+  template <HasStaticEncodedSize... Ts>
+  struct static_encoded_size<std::tuple<Ts...>>
+      : std::integral_constant<size_t, (0 + ... + static_encoded_size_v<Ts>)> {
+  };
+
+  /**
+   * Whether any bytes are valid encoding of type T having static encoded
+   * size, so that its values may be skipped without decoding.
+   * True for integers except bool, and std::array, std::pair and std::tuple
+   * of such types. Values of other types, e.g. bool and enums, are checked
+   * by decoding.
+   * Specialize it for custom types with static encoded size, which accept
+   * any bytes.
+   * @tparam T type to be encoded
+   */
+  template <typename T>
+  struct is_unchecked_encoding
+      : std::bool_constant<std::is_integral_v<T>
+                           and not std::is_same_v<T, bool>> {};
+
+  template <typename T, size_t N>
+  struct is_unchecked_encoding<std::array<T, N>>
+      : is_unchecked_encoding<std::remove_cv_t<T>> {};
+
+  template <typename F, typename S>
+  struct is_unchecked_encoding<std::pair<F, S>>
+      : std::bool_constant<is_unchecked_encoding<std::remove_cv_t<F>>::value
+                           and is_unchecked_encoding<
+                               std::remove_cv_t<S>>::value> {};
+
+  template <typename... Ts>
+  struct is_unchecked_encoding<std::tuple<Ts...>>
+      : std::bool_constant<(
+            true and ...
+            and is_unchecked_encoding<std::remove_cv_t<Ts>>::value)> {};
+
+  /// Types with static encoded size, which values may be skipped at once
+  template <typename T>
+  concept UncheckedEncoding =
+      HasStaticEncodedSize<T>
+      and is_unchecked_encoding<std::remove_cv_t<T>>::value;
+
+}  // namespace scale
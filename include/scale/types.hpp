@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include <bit>
+#include <concepts>
 #include <cstdint>
 #include <ranges>
 #include <span>
@@ -27,6 +29,31 @@ namespace scale {
   /// @brief represents compact integer value
   using CompactInteger = math::wide_integer::uint256_t;
 
+  /// @brief unsigned integer types, which can be compact-encoded natively
+  template <typename T>
+  concept NativeCompactInteger = std::unsigned_integral<T>  //
+                                 and not std::is_same_v<T, bool>
+                                 and (sizeof(T) <= sizeof(uint64_t));
+
+  /**
+   * @brief wrapper of native unsigned integer, which is compact-encoded
+   * without wide integer arithmetic
+   * @tparam T unsigned integer type
+   */
+  template <NativeCompactInteger T>
+  struct Compact {
+    T value;
+
+    bool operator==(const Compact &other) const = default;
+  };
+
+  /**
+   * Vector wrapper, that is scale encoded without prepended CompactInteger
+   */
+  struct EncodeOpaqueValue {
+    ConstSpanOfBytes v;
+  };
+
   /// @brief OptionalBool is internal extended bool type
   enum class OptionalBool : uint8_t {
     NONE = 0u,
@@ -105,6 +132,22 @@ namespace scale {
   concept RandomExtensibleCollection = DynamicCollection<T>  //
                                        and HasEmplaceMethod<T>;
 
+  /// Integer, which scale-encoded form matches its in-memory representation
+  /// on the current platform
+  template <typename T>
+  concept TriviallyEncodedInteger =
+      std::is_integral_v<T>  //
+      and not std::is_same_v<T, bool>
+      and (sizeof(T) == 1 or std::endian::native == std::endian::little);
+
+  /// Collection of integers lying in memory exactly as they are encoded,
+  /// so it can be encoded and decoded by copying the whole block of memory
+  template <class T>
+  concept TriviallyEncodedCollection =
+      std::ranges::contiguous_range<T>  //
+      and std::ranges::sized_range<T>
+      and TriviallyEncodedInteger<std::ranges::range_value_t<T>>;
+
 }  // namespace scale
 
 namespace scale::compact {
@@ -0,0 +1,136 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "scale/allocation_stats.hpp"
+
+#include <cstdlib>
+#include <new>
+
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+namespace {
+  thread_local scale::AllocationStats thread_stats;
+  thread_local size_t scope_depth = 0;
+
+  void count(size_t size) {
+    if (scope_depth != 0) {
+      ++thread_stats.allocations;
+      thread_stats.bytes += size;
+    }
+  }
+
+  void *allocate(size_t size) {
+    count(size);
+    if (auto ptr = std::malloc(size == 0 ? 1 : size)) {
+      return ptr;
+    }
+    throw std::bad_alloc();
+  }
+
+  void *allocateAligned(size_t size, std::align_val_t alignment) {
+    count(size);
+    const auto align = static_cast<size_t>(alignment);
+#ifdef _WIN32
+    if (auto ptr = _aligned_malloc(size == 0 ? 1 : size, align)) {
+      return ptr;
+    }
+#else
+    // aligned_alloc requires size to be multiple of alignment
+    const auto aligned_size = (size + align - 1) / align * align;
+    if (auto ptr = std::aligned_alloc(
+            align, aligned_size == 0 ? align : aligned_size)) {
+      return ptr;
+    }
+#endif
+    throw std::bad_alloc();
+  }
+
+  void freeAligned(void *ptr) {
+#ifdef _WIN32
+    _aligned_free(ptr);
+#else
+    std::free(ptr);
+#endif
+  }
+}  // namespace
+
+namespace scale {
+  AllocationStats allocationStats() {
+    return thread_stats;
+  }
+
+  void resetAllocationStats() {
+    thread_stats = {};
+  }
+
+  detail::AllocationScope::AllocationScope() {
+    ++scope_depth;
+  }
+
+  detail::AllocationScope::~AllocationScope() {
+    --scope_depth;
+  }
+}  // namespace scale
+
+void *operator new(size_t size) {
+  return allocate(size);
+}
+
+void *operator new[](size_t size) {
+  return allocate(size);
+}
+
+void *operator new(size_t size, const std::nothrow_t &) noexcept {
+  count(size);
+  return std::malloc(size == 0 ? 1 : size);
+}
+
+void *operator new[](size_t size, const std::nothrow_t &) noexcept {
+  count(size);
+  return std::malloc(size == 0 ? 1 : size);
+}
+
+void *operator new(size_t size, std::align_val_t alignment) {
+  return allocateAligned(size, alignment);
+}
+
+void *operator new[](size_t size, std::align_val_t alignment) {
+  return allocateAligned(size, alignment);
+}
+
+void operator delete(void *ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete[](void *ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void *ptr, size_t) noexcept {
+  std::free(ptr);
+}
+
+void operator delete[](void *ptr, size_t) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void *ptr, std::align_val_t) noexcept {
+  freeAligned(ptr);
+}
+
+void operator delete[](void *ptr, std::align_val_t) noexcept {
+  freeAligned(ptr);
+}
+
+void operator delete(void *ptr, size_t, std::align_val_t) noexcept {
+  freeAligned(ptr);
+}
+
+void operator delete[](void *ptr, size_t, std::align_val_t) noexcept {
+  freeAligned(ptr);
+}
@@ -4,77 +4,123 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <limits>
+
 #include <scale/encode_append.hpp>
 #include <scale/scale.hpp>
 
-#include "compact_len_utils.hpp"
-
 namespace scale {
 
-  /**
-   * @param data Scale encoded vector of EncodeOpaqueValues
-   * @return tuple containing:
-   *  1. new length of vector after inserting there one more EncodeOpaqueValues
-   *  2. current length of CompactInteger-scale-encoded length of
-   * EncodeOpaqueValues vector
-   *  3. length of CompactInteger-scale-encoded length of EncodeOpaqueValues
-   * vector after insertion there one more EncodeOpaqueValue
-   */
-  outcome::result<std::tuple<uint32_t, uint32_t, uint32_t>> extract_length_data(
-      const std::vector<uint8_t> &data) {
-    #ifdef _WIN32
-    CompactInteger len;
-    #endif
-    OUTCOME_TRY(len, scale::decode<CompactInteger>(data));
-    auto new_len = static_cast<std::uint32_t>(len + 1);
-    auto encoded_len = compact::compactLen(static_cast<uint32_t>(len));
-    auto encoded_new_len = compact::compactLen(new_len);
-    return std::make_tuple(new_len, encoded_len, encoded_new_len);
-  }
-
   outcome::result<void> append_or_new_vec(std::vector<uint8_t> &self_encoded,
                                           ConstSpanOfBytes input) {
-    EncodeOpaqueValue opaque_value{.v = input};
+    return append_many(self_encoded, std::span{&input, 1});
+  }
 
-    // No data present, just encode the given input data.
-    if (self_encoded.empty()) {
-      self_encoded =
-          scale::encode(std::vector<EncodeOpaqueValue>{opaque_value}).value();
+  outcome::result<void> append_many(std::vector<uint8_t> &self_encoded,
+                                    std::span<const ConstSpanOfBytes> inputs) {
+    if (inputs.empty()) {
       return outcome::success();
     }
 
-    #ifdef _WIN32
-    std::tuple<uint32_t, uint32_t, uint32_t> extract_tuple;
-    #endif
-    OUTCOME_TRY(extract_tuple, extract_length_data(self_encoded));
-    const auto &[new_len, encoded_len, encoded_new_len] = extract_tuple;
-
-    auto replace_len = [new_len = new_len](std::vector<uint8_t> &dest) {
-      auto e = scale::encode(CompactInteger{new_len}).value();
-      std::move(e.begin(), e.end(), dest.begin());
-    };
-
-    // If old and new encoded len is equal, we don't need to copy the
-    // already encoded data.
-    if (encoded_len != encoded_new_len) {
-      // reserve place for new len, old vector and new vector
-      self_encoded.reserve(encoded_new_len + (self_encoded.size() - encoded_len)
-                           + opaque_value.v.size());
-
-      // shift the data bytes in a container to give space for the new Compact
-      // encoded length prefix
-      const auto shift_size = encoded_new_len - encoded_len;
-      self_encoded.resize(self_encoded.size() + shift_size);
-      std::rotate(self_encoded.rbegin(),
-                  self_encoded.rbegin() + shift_size,
-                  self_encoded.rend());
-    } else {
-      // reserve place for existing and new vector
-      self_encoded.reserve(self_encoded.size() + opaque_value.v.size());
+    // No data present means empty vector without length prefix
+    uint64_t len = 0;
+    size_t encoded_len = 0;
+    if (not self_encoded.empty()) {
+      ScaleDecoderStream s{self_encoded};
+      s.setThrowOnError(false);
+      OUTCOME_TRY(streamCatch(s, [&] { len = s.decodeCompact<uint64_t>(); }));
+      encoded_len = s.currentIndex();
+    }
+
+    // the new length would wrap around
+    if (inputs.size() > std::numeric_limits<uint64_t>::max() - len) {
+      return DecodeError::TOO_MANY_ITEMS;
+    }
+
+    detail::NativeCompactBuffer new_len;
+    const auto encoded_new_len =
+        detail::encodeCompactInteger(len + inputs.size(), new_len);
+
+    size_t inputs_size = 0;
+    for (auto &input : inputs) {
+      inputs_size += input.size();
+    }
+    // grow geometrically, so that appending by small batches stays linear
+    const auto new_size =
+        encoded_new_len + (self_encoded.size() - encoded_len) + inputs_size;
+    if (self_encoded.capacity() < new_size) {
+      self_encoded.reserve(std::max(new_size, self_encoded.capacity() * 2));
+    }
+
+    // shift the encoded items once to fit the new length prefix
+    if (encoded_new_len > encoded_len) {
+      self_encoded.insert(
+          self_encoded.begin(), encoded_new_len - encoded_len, uint8_t{0});
+    } else if (encoded_new_len < encoded_len) {
+      self_encoded.erase(
+          self_encoded.begin(),
+          self_encoded.begin()
+              + static_cast<ptrdiff_t>(encoded_len - encoded_new_len));
+    }
+    std::copy_n(new_len.begin(), encoded_new_len, self_encoded.begin());
+
+    for (auto &input : inputs) {
+      self_encoded.insert(self_encoded.end(), input.begin(), input.end());
     }
-    replace_len(self_encoded);
-    self_encoded.insert(
-        self_encoded.end(), opaque_value.v.begin(), opaque_value.v.end());
     return outcome::success();
   }
+
+  AppendableEncodedVec::AppendableEncodedVec() : buffer_(kMaxPrefixSize) {
+    updatePrefix();
+  }
+
+  outcome::result<AppendableEncodedVec> AppendableEncodedVec::fromEncoded(
+      ConstSpanOfBytes encoded) {
+    AppendableEncodedVec vec;
+    if (encoded.empty()) {
+      return vec;
+    }
+    ScaleDecoderStream s{encoded};
+    s.setThrowOnError(false);
+    uint64_t size = 0;
+    OUTCOME_TRY(streamCatch(s, [&] { size = s.decodeCompact<uint64_t>(); }));
+    auto items = encoded.subspan(s.currentIndex());
+    vec.buffer_.insert(vec.buffer_.end(), items.begin(), items.end());
+    vec.size_ = size;
+    vec.updatePrefix();
+    return vec;
+  }
+
+  void AppendableEncodedVec::append(ConstSpanOfBytes input) {
+    buffer_.insert(buffer_.end(), input.begin(), input.end());
+    ++size_;
+    updatePrefix();
+  }
+
+  void AppendableEncodedVec::append(std::span<const ConstSpanOfBytes> inputs) {
+    for (auto &input : inputs) {
+      buffer_.insert(buffer_.end(), input.begin(), input.end());
+    }
+    size_ += inputs.size();
+    updatePrefix();
+  }
+
+  std::vector<uint8_t> AppendableEncodedVec::take() {
+    auto encoded = std::exchange(buffer_, std::vector<uint8_t>(kMaxPrefixSize));
+    encoded.erase(encoded.begin(),
+                  encoded.begin()
+                      + static_cast<ptrdiff_t>(kMaxPrefixSize - prefix_size_));
+    size_ = 0;
+    updatePrefix();
+    return encoded;
+  }
+
+  void AppendableEncodedVec::updatePrefix() {
+    detail::NativeCompactBuffer prefix;
+    prefix_size_ = detail::encodeCompactInteger(size_, prefix);
+    std::copy_n(prefix.begin(),
+                prefix_size_,
+                buffer_.begin()
+                    + static_cast<ptrdiff_t>(kMaxPrefixSize - prefix_size_));
+  }
 }  // namespace scale
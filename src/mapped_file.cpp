@@ -0,0 +1,137 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "scale/mapped_file.hpp"
+
+#include <cerrno>
+#include <system_error>
+#include <utility>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace scale {
+  namespace {
+    std::error_code lastError() {
+#ifdef _WIN32
+      return {static_cast<int>(::GetLastError()), std::system_category()};
+#else
+      return {errno, std::system_category()};
+#endif
+    }
+  }  // namespace
+
+#ifdef _WIN32
+  outcome::result<MappedFile> MappedFile::open(const std::string &path) {
+    // sequential scan hint makes the cache manager read ahead
+    HANDLE file = ::CreateFileA(path.c_str(),
+                                GENERIC_READ,
+                                FILE_SHARE_READ,
+                                nullptr,
+                                OPEN_EXISTING,
+                                FILE_FLAG_SEQUENTIAL_SCAN,
+                                nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+      return lastError();
+    }
+    LARGE_INTEGER file_size{};
+    if (not ::GetFileSizeEx(file, &file_size)) {
+      auto error = lastError();
+      ::CloseHandle(file);
+      return error;
+    }
+    auto size = static_cast<size_t>(file_size.QuadPart);
+    if (size == 0) {
+      // empty mapping is not allowed
+      ::CloseHandle(file);
+      return MappedFile{nullptr, 0};
+    }
+    HANDLE mapping =
+        ::CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    auto error = lastError();
+    ::CloseHandle(file);
+    if (mapping == nullptr) {
+      return error;
+    }
+    void *data = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    error = lastError();
+    // view stays valid after the mapping handle is closed
+    ::CloseHandle(mapping);
+    if (data == nullptr) {
+      return error;
+    }
+    return MappedFile{static_cast<const uint8_t *>(data), size};
+  }
+#else
+  outcome::result<MappedFile> MappedFile::open(const std::string &path) {
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+      return lastError();
+    }
+    struct stat st {};
+    if (::fstat(fd, &st) != 0) {
+      auto error = lastError();
+      ::close(fd);
+      return error;
+    }
+    auto size = static_cast<size_t>(st.st_size);
+    if (size == 0) {
+      // empty mapping is not allowed
+      ::close(fd);
+      return MappedFile{nullptr, 0};
+    }
+    void *data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    auto error = lastError();
+    // mapping stays valid after the descriptor is closed
+    ::close(fd);
+    if (data == MAP_FAILED) {
+      return error;
+    }
+    // only a hint, failure is not an error
+    ::madvise(data, size, MADV_SEQUENTIAL);
+    return MappedFile{static_cast<const uint8_t *>(data), size};
+  }
+#endif
+
+  MappedFile::MappedFile(MappedFile &&other) noexcept
+      : data_{std::exchange(other.data_, nullptr)},
+        size_{std::exchange(other.size_, 0)} {}
+
+  MappedFile &MappedFile::operator=(MappedFile &&other) noexcept {
+    if (this != &other) {
+      unmap();
+      data_ = std::exchange(other.data_, nullptr);
+      size_ = std::exchange(other.size_, 0);
+    }
+    return *this;
+  }
+
+  MappedFile::~MappedFile() {
+    unmap();
+  }
+
+  void MappedFile::unmap() {
+    if (data_ != nullptr) {
+#ifdef _WIN32
+      ::UnmapViewOfFile(data_);
+#else
+      ::munmap(const_cast<uint8_t *>(data_), size_);  // NOLINT
+#endif
+      data_ = nullptr;
+      size_ = 0;
+    }
+  }
+
+}  // namespace scale
@@ -6,6 +6,10 @@
 
 #include "scale/scale_decoder_stream.hpp"
 
+#include <algorithm>
+
+#include "scale/detail/compact_integer.hpp"
+
 namespace scale {
   namespace {
     CompactInteger decodeCompactInteger(ScaleDecoderStream &stream) {
@@ -31,16 +35,12 @@ namespace scale {
         }
 
         case 0b10u: {
+          std::array<uint8_t, 3> bytes{};
+          stream.nextBytes(bytes);
           number = first_byte;
           size_t multiplier = 256u;
-          if (!stream.hasMore(3u)) {
-            raise(DecodeError::NOT_ENOUGH_DATA);
-          }
-
-          for (auto i = 0u; i < 3u; ++i) {
-            // we assured that there are 3 more bytes,
-            // no need to make checks in a loop
-            number += (stream.nextByte()) * multiplier;
+          for (auto byte : bytes) {
+            number += byte * multiplier;
             multiplier = multiplier << 8u;
           }
           number = number >> 2u;
@@ -49,20 +49,15 @@ namespace scale {
 
         case 0b11: {
           auto bytes_count = ((first_byte) >> 2u) + 4u;
-          if (!stream.hasMore(bytes_count)) {
-            raise(DecodeError::NOT_ENOUGH_DATA);
+          // at most 67 bytes, those beyond 256 bits are dropped,
+          // as the value wraps around
+          std::array<uint8_t, detail::kMaxCompactIntegerSize - 1> buffer{};
+          auto bytes = std::span(buffer).first(bytes_count);
+          stream.nextBytes(bytes);
+          if (stream.error()) {
+            return 0;
           }
-
-          CompactInteger multiplier{1u};
-          CompactInteger value = 0;
-          // we assured that there are m more bytes,
-          // no need to make checks in a loop
-          for (auto i = 0u; i < bytes_count; ++i) {
-            value += (stream.nextByte()) * multiplier;
-            multiplier *= 256u;
-          }
-
-          return value;  // special case
+          return detail::loadCompactIntegerBytes(bytes);  // special case
         }
 
         default:
@@ -73,14 +68,70 @@ namespace scale {
     }
   }  // namespace
 
+  uint64_t ScaleDecoderStream::decodeCompactUint64() {
+    const auto first_byte = nextByte();
+    const auto flag = first_byte & 0b11u;
+
+    if (flag == 0b00u) {
+      return first_byte >> 2u;
+    }
+
+    // modes 0b01 and 0b10 take 2 and 4 bytes in total respectively
+    if (flag != 0b11u) {
+      const size_t rest = flag == 0b01u ? 1 : 3;
+      if (not requireMore(rest)) {
+        return 0;
+      }
+      uint32_t value = first_byte;
+      for (size_t i = 0; i < rest; ++i) {
+        value |= static_cast<uint32_t>(span_[current_index_ + i])
+                 << (8 * (i + 1));
+      }
+      current_index_ += rest;
+      return value >> 2u;
+    }
+
+    const size_t bytes_count = (first_byte >> 2u) + 4u;
+    if (not requireMore(bytes_count)) {
+      return 0;
+    }
+    const auto bytes = span_.subspan(current_index_, bytes_count);
+    // bytes above 64 bits are allowed only if they are zero
+    if (bytes_count > sizeof(uint64_t)
+        and std::any_of(bytes.begin() + sizeof(uint64_t),
+                        bytes.end(),
+                        [](uint8_t byte) { return byte != 0; })) {
+      fail(DecodeError::TOO_MANY_ITEMS);
+      return 0;
+    }
+    uint64_t value = 0;
+    for (size_t i = std::min(bytes_count, sizeof(uint64_t)); i > 0; --i) {
+      value = (value << 8u) | bytes[i - 1];
+    }
+    current_index_ += bytes_count;
+    return value;
+  }
+
   size_t ScaleDecoderStream::decodeLength() {
     size_t size = decodeCompact<size_t>();
-    if (not hasMore(size)) {
-      raise(DecodeError::NOT_ENOUGH_DATA);
+    if (not requireMore(size)) {
+      return 0;
     }
     return size;
   }
 
+  ConstSpanOfBytes ScaleDecoderStream::borrowBytes() {
+    // views taken in skip mode are never exposed
+    if (not borrowing_ and not skipping_) {
+      fail(DecodeError::BORROWING_NOT_ALLOWED);
+      return {};
+    }
+    auto size = decodeLength();
+    auto bytes = span_.subspan(current_index_, size);
+    current_index_ += size;
+    return bytes;
+  }
+
   std::optional<bool> ScaleDecoderStream::decodeOptionalBool() {
     auto byte = nextByte();
     switch (static_cast<OptionalBool>(byte)) {
@@ -91,7 +142,8 @@ namespace scale {
       case OptionalBool::OPT_TRUE:
         return true;
     }
-    raise(DecodeError::UNEXPECTED_VALUE);
+    fail(DecodeError::UNEXPECTED_VALUE);
+    return std::nullopt;
   }
 
   bool ScaleDecoderStream::decodeBool() {
@@ -102,7 +154,8 @@ namespace scale {
       case 1u:
         return true;
       default:
-        raise(DecodeError::UNEXPECTED_VALUE);
+        fail(DecodeError::UNEXPECTED_VALUE);
+        return false;
     }
   }
 
@@ -113,35 +166,27 @@ namespace scale {
 
   ScaleDecoderStream &ScaleDecoderStream::operator>>(BitVec &v) {
     auto size = decodeCompact<size_t>();
-    if (not hasMore((size + 7) / 8)) {
-      raise(DecodeError::NOT_ENOUGH_DATA);
+    auto byte_count = BitVec::byteCount(size);
+    if (not requireMore(byte_count)) {
+      return *this;
     }
-    v.bits.resize(size);
-    size_t i = 0;
-    uint8_t byte = 0;
-    for (std::vector<bool>::reference bit : v.bits) {
-      if (i % 8 == 0) {
-        byte = nextByte();
-      }
-      bit = ((byte >> (i % 8)) & 1) != 0;
-      ++i;
+    if (not skipping_) {
+      v.assign(size, span_.subspan(current_index_, byte_count));
     }
-
+    current_index_ += byte_count;
     return *this;
   }
 
-  bool ScaleDecoderStream::hasMore(uint64_t n) const {
-    return static_cast<size_t>(current_index_ + n) <= span_.size();
-  }
-
   void ScaleDecoderStream::seek(size_t size) {
+    assert(hasMore(size));
     current_index_ += size;
   }
 
-  uint8_t ScaleDecoderStream::nextByte() {
-    if (not hasMore(1)) {
-      raise(DecodeError::NOT_ENOUGH_DATA);
+  void ScaleDecoderStream::nextBytes(MutSpanOfBytes out) {
+    if (not requireMore(out.size())) {
+      return;
     }
-    return span_[current_index_++];
+    std::copy_n(span_.begin() + current_index_, out.size(), out.begin());
+    current_index_ += out.size();
   }
 }  // namespace scale
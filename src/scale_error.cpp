@@ -15,6 +15,10 @@ OUTCOME_CPP_DEFINE_CATEGORY(scale, EncodeError, e) {
       return "SCALE encode: compact integers too big";
     case EncodeError::DEREF_NULLPOINTER:
       return "SCALE encode: attempt to dereference a nullptr";
+    case EncodeError::BUFFER_TOO_SMALL:
+      return "SCALE encode: encoded data does not fit the buffer";
+    case EncodeError::VALUELESS_VARIANT:
+      return "SCALE encode: variant holds no value";
   }
   return "unknown EncodeError";
 }
@@ -33,6 +37,9 @@ OUTCOME_CPP_DEFINE_CATEGORY(scale, DecodeError, e) {
       return "SCALE decode: wrong type index, cannot decode variant";
     case DecodeError::INVALID_ENUM_VALUE:
       return "SCALE decode: decoded enum value does not belong to the enum";
+    case DecodeError::BORROWING_NOT_ALLOWED:
+      return "SCALE decode: views into decoded data can be decoded only by "
+             "borrowing stream";
   }
   return "unknown SCALE DecodeError";
 }
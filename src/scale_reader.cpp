@@ -0,0 +1,60 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "scale/scale_reader.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <istream>
+#include <limits>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace scale {
+  outcome::result<size_t> ByteSource::read(MutSpanOfBytes out) {
+    if (in_ != nullptr) {
+      auto *data = reinterpret_cast<char *>(out.data());  // NOLINT
+      std::streamsize size = 0;
+      // waits for the first byte only, then takes what is available without
+      // waiting, so that data is decoded as it comes, e.g. from a pipe
+      if (not out.empty()
+          and in_->peek() != std::istream::traits_type::eof()) {
+        size = in_->readsome(data, static_cast<std::streamsize>(out.size()));
+        if (size == 0 and not in_->bad()) {
+          // stream buffer does not tell how much data it has
+          in_->read(data, 1);
+          size = in_->gcount();
+        }
+      }
+      if (in_->bad()) {
+        return std::make_error_code(std::io_errc::stream);
+      }
+      return static_cast<size_t>(size);
+    }
+    while (true) {
+#ifdef _WIN32
+      auto size = ::_read(
+          fd_,
+          out.data(),
+          static_cast<unsigned>(std::min<size_t>(
+              out.size(), std::numeric_limits<int>::max())));
+#else
+      auto size = ::read(fd_, out.data(), out.size());
+#endif
+      if (size >= 0) {
+        return static_cast<size_t>(size);
+      }
+      if (errno != EINTR) {
+        return std::error_code{errno, std::system_category()};
+      }
+    }
+  }
+
+}  // namespace scale
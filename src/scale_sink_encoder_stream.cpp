@@ -0,0 +1,116 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "scale/scale_sink_encoder_stream.hpp"
+
+#include <array>
+#include <cerrno>
+#include <limits>
+#include <ostream>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <sys/uio.h>
+#endif
+
+namespace scale {
+  ScaleSinkEncoderStream::ScaleSinkEncoderStream(int fd, size_t buffer_size)
+      : fd_{fd}, buffer_(std::max<size_t>(buffer_size, 1)) {}
+
+  ScaleSinkEncoderStream::ScaleSinkEncoderStream(std::ostream &out,
+                                                 size_t buffer_size)
+      : out_{&out}, buffer_(std::max<size_t>(buffer_size, 1)) {}
+
+  ScaleSinkEncoderStream::~ScaleSinkEncoderStream() {
+    setThrowOnError(false);
+#ifndef BOOST_NO_EXCEPTIONS
+    try {
+#endif
+      flush();
+#ifndef BOOST_NO_EXCEPTIONS
+    } catch (...) {
+      // std::ostream with enabled exceptions must not terminate the program
+    }
+#endif
+  }
+
+  ScaleSinkEncoderStream &ScaleSinkEncoderStream::flush() {
+    write({});
+    if (out_ != nullptr and not error() and not out_->flush()) {
+      fail(std::make_error_code(std::io_errc::stream));
+    }
+    return *this;
+  }
+
+  void ScaleSinkEncoderStream::write(ConstSpanOfBytes tail) {
+    ConstSpanOfBytes head{buffer_.data(), buffered_};
+    buffered_ = 0;
+    // data following the failure would be written at wrong offset
+    if (error()) {
+      return;
+    }
+
+    if (out_ != nullptr) {
+      out_->write(reinterpret_cast<const char *>(head.data()),  // NOLINT
+                  static_cast<std::streamsize>(head.size()));
+      out_->write(reinterpret_cast<const char *>(tail.data()),  // NOLINT
+                  static_cast<std::streamsize>(tail.size()));
+      if (not *out_) {
+        fail(std::make_error_code(std::io_errc::stream));
+      }
+      return;
+    }
+
+#ifdef _WIN32
+    for (auto part : {head, tail}) {
+      while (not part.empty()) {
+        auto size = std::min<size_t>(part.size(),
+                                     std::numeric_limits<int>::max());
+        auto written =
+            ::_write(fd_, part.data(), static_cast<unsigned>(size));
+        if (written < 0) {
+          fail(std::error_code{errno, std::system_category()});
+          return;
+        }
+        part = part.subspan(static_cast<size_t>(written));
+      }
+    }
+#else
+    std::array<iovec, 2> parts{{
+        {const_cast<uint8_t *>(head.data()), head.size()},  // NOLINT
+        {const_cast<uint8_t *>(tail.data()), tail.size()},  // NOLINT
+    }};
+    auto *part = parts.data();
+    auto *end = parts.data() + parts.size();
+    while (part != end) {
+      if (part->iov_len == 0) {
+        ++part;
+        continue;
+      }
+      auto written = ::writev(fd_, part, static_cast<int>(end - part));
+      if (written < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        fail(std::error_code{errno, std::system_category()});
+        return;
+      }
+      // writing may be partial, the rest is written by the next call
+      auto n = static_cast<size_t>(written);
+      while (part != end and n >= part->iov_len) {
+        n -= part->iov_len;
+        ++part;
+      }
+      if (part != end) {
+        part->iov_base = static_cast<uint8_t *>(part->iov_base) + n;
+        part->iov_len -= n;
+      }
+    }
+#endif
+  }
+
+}  // namespace scale
@@ -0,0 +1,70 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "scale/scale.hpp"
+#include "util/outcome.hpp"
+
+using scale::allocationStats;
+using scale::AllocationStats;
+using scale::decode;
+using scale::encode;
+using scale::resetAllocationStats;
+
+class AllocationStatsTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    resetAllocationStats();
+  }
+};
+
+/**
+ * @given encoded fixed-size structure
+ * @when it is decoded
+ * @then no allocations are made
+ */
+TEST_F(AllocationStatsTest, FixedSizeDecodeDoesNotAllocate) {
+  using Header = std::tuple<uint32_t, uint64_t, std::array<uint8_t, 32>>;
+  EXPECT_OUTCOME_TRUE(encoded, encode(Header{1, 2, {3}}));
+  resetAllocationStats();
+
+  EXPECT_OUTCOME_TRUE(decoded, decode<Header>(encoded));
+  EXPECT_EQ(std::get<0>(decoded), 1);
+  EXPECT_EQ(allocationStats(), AllocationStats{});
+}
+
+/**
+ * @given encoded vector of integers
+ * @when it is decoded
+ * @then single allocation of memory for all of its items is counted
+ */
+TEST_F(AllocationStatsTest, VectorDecodeAllocatesOnce) {
+  EXPECT_OUTCOME_TRUE(encoded, encode(std::vector<uint32_t>(100, 7)));
+  resetAllocationStats();
+
+  EXPECT_OUTCOME_TRUE(decoded, decode<std::vector<uint32_t>>(encoded));
+  EXPECT_EQ(decoded.size(), 100);
+  EXPECT_EQ(allocationStats().allocations, 1);
+  EXPECT_EQ(allocationStats().bytes, 400);
+}
+
+/**
+ * @given allocations made outside of encoding and on other threads
+ * @when allocation stats are taken
+ * @then only allocations of encoding on the current thread are counted
+ */
+TEST_F(AllocationStatsTest, CountsOnlyEncodingOnCurrentThread) {
+  auto unrelated = std::make_unique<std::vector<int>>(10);
+  std::thread([] { std::ignore = encode(std::string(100, 'a')); }).join();
+  EXPECT_EQ(allocationStats(), AllocationStats{});
+
+  EXPECT_OUTCOME_TRUE(encoded, encode(std::string(100, 'a')));
+  EXPECT_GE(allocationStats().allocations, 1);
+  EXPECT_GE(allocationStats().bytes, encoded.size());
+}
@@ -0,0 +1,94 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+
+#include "scale/scale.hpp"
+#include "util/outcome.hpp"
+
+using scale::ByteArray;
+using scale::ConstSpanOfBytes;
+using scale::decode;
+using scale::decodeBorrowed;
+using scale::DecodeError;
+using scale::encode;
+
+struct Extrinsic {
+  uint32_t index;
+  std::string_view name;
+  ConstSpanOfBytes payload;
+};
+
+template <class Stream, typename = std::enable_if_t<Stream::is_decoder_stream>>
+Stream &operator>>(Stream &s, Extrinsic &v) {
+  return s >> v.index >> v.name >> v.payload;
+}
+
+/**
+ * @given encoded structures containing strings and byte vectors
+ * @when they are decoded by borrowing stream to views
+ * @then views point into the encoded data and have expected content
+ */
+TEST(BorrowedDecode, ViewsPointIntoInput) {
+  std::vector<std::tuple<uint32_t, std::string, ByteArray>> values{
+      {1, "first", {1, 2, 3}}, {2, "", {}}, {3, "third", ByteArray(100, 7)}};
+  EXPECT_OUTCOME_TRUE(encoded, encode(values));
+
+  EXPECT_OUTCOME_TRUE(decoded, decodeBorrowed<std::vector<Extrinsic>>(encoded));
+  ASSERT_EQ(decoded.size(), values.size());
+  for (size_t i = 0; i < values.size(); ++i) {
+    auto &[index, name, payload] = values[i];
+    ASSERT_EQ(decoded[i].index, index);
+    ASSERT_EQ(decoded[i].name, name);
+    ASSERT_TRUE(std::ranges::equal(decoded[i].payload, payload));
+    if (not payload.empty()) {
+      ASSERT_GE(decoded[i].payload.data(), encoded.data());
+      ASSERT_LT(decoded[i].payload.data(), encoded.data() + encoded.size());
+    }
+  }
+}
+
+/**
+ * @given encoded string
+ * @when it is decoded to view by non-borrowing stream
+ * @then BORROWING_NOT_ALLOWED error is returned
+ */
+TEST(BorrowedDecode, NotAllowedWithoutOptIn) {
+  EXPECT_OUTCOME_TRUE(encoded, encode(std::string("text")));
+  EXPECT_EC(decode<std::string_view>(encoded),
+            DecodeError::BORROWING_NOT_ALLOWED);
+  EXPECT_OUTCOME_TRUE(view, decodeBorrowed<std::string_view>(encoded));
+  ASSERT_EQ(view, "text");
+}
+
+/**
+ * @given encoded byte collection which is longer than the data
+ * @when it is decoded to view
+ * @then NOT_ENOUGH_DATA error is returned
+ */
+TEST(BorrowedDecode, NotEnoughData) {
+  ByteArray encoded{12, 1, 2};
+  EXPECT_EC(decodeBorrowed<ConstSpanOfBytes>(encoded),
+            DecodeError::NOT_ENOUGH_DATA);
+}
+
+/**
+ * @given byte collection with length prefix close to the max value of size_t
+ * @when it is decoded to view or skipped
+ * @then NOT_ENOUGH_DATA error is returned instead of view past the data
+ */
+TEST(BorrowedDecode, HugeLength) {
+  ByteArray encoded{0x13, 0xfe, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x61};
+  EXPECT_EC(decodeBorrowed<std::string_view>(encoded),
+            DecodeError::NOT_ENOUGH_DATA);
+  EXPECT_EC(decodeBorrowed<ConstSpanOfBytes>(encoded),
+            DecodeError::NOT_ENOUGH_DATA);
+
+  scale::ScaleDecoderStream stream{encoded};
+  stream.setThrowOnError(false);
+  stream.skip<std::string_view>();
+  EXPECT_EQ(stream.error(), DecodeError::NOT_ENOUGH_DATA);
+}
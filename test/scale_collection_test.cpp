@@ -4,6 +4,8 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <deque>
+
 #include <gtest/gtest.h>
 
 #include "scale/scale.hpp"
@@ -67,12 +69,48 @@ TEST(Scale, encodeVectorOfBool) {
 }
 
 TEST(Scale, encodeBitVec) {
-  auto v = BitVec{{true, true, false, false, false, false, true}};
+  auto v = BitVec{true, true, false, false, false, false, true};
   auto encoded = ByteArray{(7 << 2), 0b01000011};
   ASSERT_EQ(encode(v).value(), encoded);
   ASSERT_EQ(decode<BitVec>(encoded).value(), v);
 }
 
+/**
+ * @given bit vector of bits set by index and by resizing
+ * @when it is encoded and decoded back
+ * @then bytes are packed Lsb0, decoded vector is equal to original
+ */
+TEST(Scale, BitVecBits) {
+  BitVec v(10);
+  v.set(0);
+  v.set(9);
+  v.resize(13, true);
+  v.push_back(false);
+  v.set(12, false);
+  ASSERT_EQ(v.size(), 14);
+  EXPECT_EQ(v.count(), 4);
+  EXPECT_TRUE(v[0] and v[9] and v[10] and v[11]);
+  EXPECT_FALSE(v[1] or v[12] or v[13]);
+
+  auto encoded = ByteArray{(14 << 2), 0b00000001, 0b00001110};
+  ASSERT_EQ(encode(v).value(), encoded);
+  ASSERT_EQ(decode<BitVec>(encoded).value(), v);
+
+  v.resize(9);
+  EXPECT_EQ(v, (BitVec{true, false, false, false, false, false, false, false,
+                       false}));
+}
+
+/**
+ * @given encoded bit vector with unused bits of the last byte set
+ * @when it is decoded
+ * @then unused bits are ignored
+ */
+TEST(Scale, BitVecUnusedBits) {
+  auto encoded = ByteArray{(3 << 2), 0b11111101};
+  ASSERT_EQ(decode<BitVec>(encoded).value(), (BitVec{true, false, true}));
+}
+
 /**
  * @given collection of items of type uint16_t
  * @when encodeCollection is applied
@@ -505,3 +543,44 @@ TEST(Scale, encodeStaticSpan) {
   ASSERT_TRUE(std::equal(
       decoded.begin(), decoded.end(), collection.begin(), collection.end()));
 }
+
+/**
+ * @given contiguous collections of integers and non-contiguous collections
+ * with the same items
+ * @when they are encoded and decoded
+ * @then encoded data is the same and decoded data equals to the original one
+ */
+TEST(Scale, encodeContiguousIntegerCollections) {
+  std::vector<int64_t> vector{-1, 0, 1, std::numeric_limits<int64_t>::min()};
+  std::deque<int64_t> deque(vector.begin(), vector.end());
+  EXPECT_OUTCOME_TRUE(encoded_vector, encode(vector));
+  EXPECT_OUTCOME_TRUE(encoded_deque, encode(deque));
+  ASSERT_EQ(encoded_vector, encoded_deque);
+  EXPECT_OUTCOME_TRUE(decoded_vector,
+                      decode<std::vector<int64_t>>(encoded_vector));
+  ASSERT_EQ(decoded_vector, vector);
+
+  std::array<uint8_t, 32> hash{};
+  for (size_t i = 0; i < hash.size(); ++i) {
+    hash[i] = static_cast<uint8_t>(i * 7);
+  }
+  EXPECT_OUTCOME_TRUE(encoded_hash, encode(hash));
+  ASSERT_EQ(encoded_hash, ByteArray(hash.begin(), hash.end()));
+  EXPECT_OUTCOME_TRUE(decoded_hash,
+                      (decode<std::array<uint8_t, 32>>(encoded_hash)));
+  ASSERT_EQ(decoded_hash, hash);
+}
+
+/**
+ * @given truncated encoded collections of integers
+ * @when they are decoded
+ * @then NOT_ENOUGH_DATA error is returned
+ */
+TEST(Scale, decodeTruncatedIntegerCollection) {
+  // 2 items of uint32_t, but only 7 bytes of data
+  ByteArray bytes{8, 1, 0, 0, 0, 2, 0, 0};
+  EXPECT_EC(decode<std::vector<uint32_t>>(bytes),
+            DecodeError::NOT_ENOUGH_DATA);
+  EXPECT_EC((decode<std::array<uint16_t, 5>>(bytes)),
+            DecodeError::NOT_ENOUGH_DATA);
+}
@@ -158,3 +158,123 @@ TEST(Scale, compactDecodeBigIntegerError) {
   auto bytes = ByteArray{255, 255, 255, 255};
   EXPECT_EC(decode<CompactInteger>(bytes), scale::DecodeError::NOT_ENOUGH_DATA);
 }
+
+/**
+ * @given native unsigned integers around boundaries of compact categories
+ * @when they are encoded as Compact and as CompactInteger
+ * @then encoded data is the same and is decoded back to the original value
+ */
+TEST(ScaleCompactTest, NativeCompactMatchesCompactInteger) {
+  std::vector<uint64_t> values{0,
+                               1,
+                               63,
+                               64,
+                               16383,
+                               16384,
+                               1073741823ull,
+                               1073741824ull,
+                               (1ull << 32) - 1,
+                               1ull << 32,
+                               (1ull << 56) - 1,
+                               1ull << 56,
+                               std::numeric_limits<uint64_t>::max()};
+  for (auto value : values) {
+    EXPECT_OUTCOME_TRUE(native, scale::encode(scale::Compact{value}));
+    EXPECT_OUTCOME_TRUE(wide, scale::encode(CompactInteger{value}));
+    ASSERT_EQ(native, wide) << value;
+
+    EXPECT_OUTCOME_TRUE(decoded, decode<scale::Compact<uint64_t>>(native));
+    ASSERT_EQ(decoded.value, value);
+    EXPECT_OUTCOME_TRUE(decoded_wide, decode<CompactInteger>(native));
+    ASSERT_EQ(decoded_wide, CompactInteger{value});
+  }
+}
+
+/**
+ * @given compact-encoded values exceeding range of a native type
+ * @when they are decoded as compact of that type
+ * @then TOO_MANY_ITEMS error is returned
+ */
+TEST(ScaleCompactTest, NativeCompactOverflow) {
+  EXPECT_OUTCOME_TRUE(encoded, scale::encode(scale::Compact<uint32_t>{256}));
+  EXPECT_EC(decode<scale::Compact<uint8_t>>(encoded),
+            scale::DecodeError::TOO_MANY_ITEMS);
+
+  // 2^64 takes 9 bytes
+  ByteArray big{0b10111, 0, 0, 0, 0, 0, 0, 0, 0, 1};
+  EXPECT_EC(decode<scale::Compact<uint64_t>>(big),
+            scale::DecodeError::TOO_MANY_ITEMS);
+
+  // leading zero bytes are allowed
+  ByteArray zero_padded{0b10111, 1, 0, 0, 0, 0, 0, 0, 0, 0};
+  EXPECT_OUTCOME_TRUE(decoded, decode<scale::Compact<uint64_t>>(zero_padded));
+  ASSERT_EQ(decoded.value, 1);
+}
+
+namespace {
+  template <typename T>
+  concept HasCompactLen = requires(T v) { scale::compact::compactLen(v); };
+}  // namespace
+
+/**
+ * @given values of all compact categories
+ * @when their compact-encoded length is computed
+ * @then it matches both size of encoded data and size counted by
+ * ScaleEncodeCounter
+ */
+TEST(ScaleCompactTest, CompactLen) {
+  static_assert(HasCompactLen<uint8_t>);
+  static_assert(HasCompactLen<CompactInteger>);
+  static_assert(not HasCompactLen<bool>);
+  static_assert(not HasCompactLen<int>);
+  static_assert(not HasCompactLen<int64_t>);
+  static_assert(scale::compact::countBytes(uint64_t{0}) == 1);
+  static_assert(scale::compact::countBytes(uint64_t{0x1FF}) == 2);
+  static_assert(scale::compact::compactLen(63u) == 1);
+  static_assert(scale::compact::compactLen(64u) == 2);
+  static_assert(scale::compact::compactLen(uint64_t{1} << 30) == 5);
+  static_assert(scale::compact::compactLen(~uint64_t{0}) == 9);
+
+  std::vector<CompactInteger> values{0, 63, 64, 16384, 1ull << 30};
+  CompactInteger big = 1;
+  for (size_t bits = 1; bits < 256; ++bits) {
+    big <<= 1;
+    values.push_back(big - 1);
+    values.push_back(big);
+  }
+  for (auto &value : values) {
+    EXPECT_OUTCOME_TRUE(encoded, scale::encode(value));
+    EXPECT_EQ(scale::compact::compactLen(value), encoded.size()) << value;
+    EXPECT_OUTCOME_TRUE(counted, scale::encodedSize(value));
+    EXPECT_EQ(counted, encoded.size());
+    if (value <= std::numeric_limits<uint64_t>::max()) {
+      auto native = static_cast<uint64_t>(value);
+      EXPECT_EQ(scale::compact::compactLen(native), encoded.size());
+      EXPECT_OUTCOME_TRUE(counted_native,
+                          scale::encodedSize(scale::Compact{native}));
+      EXPECT_EQ(counted_native, encoded.size());
+    }
+  }
+}
+
+/**
+ * @given big integers of 9..32 bytes with distinct bytes
+ * @when they are encoded and decoded
+ * @then bytes are stored in little-endian order after the header, and the
+ * values are restored
+ */
+TEST(ScaleCompactTest, BigIntegerBytes) {
+  for (size_t length = 9; length <= 32; ++length) {
+    CompactInteger value = 0;
+    ByteArray expected{static_cast<uint8_t>(((length - 4) << 2u) | 0b11u)};
+    for (size_t i = 0; i < length; ++i) {
+      auto byte = static_cast<uint8_t>(0xA0 + i);
+      value |= CompactInteger{byte} << static_cast<unsigned>(8 * i);
+      expected.push_back(byte);
+    }
+    EXPECT_OUTCOME_TRUE(encoded, scale::encode(value));
+    EXPECT_EQ(encoded, expected);
+    EXPECT_OUTCOME_TRUE(decoded, decode<CompactInteger>(encoded));
+    EXPECT_EQ(decoded, value);
+  }
+}
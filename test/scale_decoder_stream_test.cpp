@@ -59,3 +59,42 @@ TEST(ScaleDecoderStreamTest, HasMoreTest) {
 
   ASSERT_ANY_THROW(stream.nextByte());
 }
+
+/**
+ * @given stream which does not throw on errors and truncated data
+ * @when values are decoded from it one after another
+ * @then nothing is thrown, the first error is kept and further reading
+ * fails without consuming data
+ */
+TEST(ScaleDecoderStreamTest, ErrorStateTest) {
+  auto bytes = ByteArray{12, 1, 2, 3, 4};
+  auto stream = ScaleDecoderStream{bytes};
+  stream.setThrowOnError(false);
+
+  std::vector<uint16_t> items;
+  uint8_t byte = 255u;
+  ASSERT_NO_THROW(stream >> items >> byte);
+  ASSERT_EQ(stream.error(), scale::DecodeError::NOT_ENOUGH_DATA);
+  ASSERT_EQ(byte, 0);
+  ASSERT_EQ(stream.currentIndex(), 1);
+  ASSERT_FALSE(stream.hasMore(1));
+}
+
+/**
+ * @given stream which does not throw on errors and malformed data
+ * @when value is decoded
+ * @then error of malformed data is kept
+ */
+TEST(ScaleDecoderStreamTest, ErrorStateUnexpectedValueTest) {
+  auto bytes = ByteArray{1, 7, 1};
+  auto stream = ScaleDecoderStream{bytes};
+  stream.setThrowOnError(false);
+
+  bool first = false;
+  bool second = false;
+  bool third = false;
+  stream >> first >> second >> third;
+  ASSERT_EQ(stream.error(), scale::DecodeError::UNEXPECTED_VALUE);
+  ASSERT_TRUE(first);
+  ASSERT_FALSE(third);
+}
@@ -10,6 +10,8 @@
 
 #include <scale/scale.hpp>
 
+#include "util/outcome.hpp"
+
 namespace scale {
   using Values = std::vector<int>;
 
@@ -30,4 +32,105 @@ namespace scale {
         append_or_new_vec(out, scale::encode(value).value()).has_error());
     EXPECT_EQ(out, scale::encode(values).value());
   }
+
+  /**
+   * @given encoded vectors of different lengths, including ones whose
+   * length prefix gets longer
+   * @when items are appended by append_many
+   * @then result is the same as of appending them one by one
+   */
+  TEST(EncodeAppend, AppendManySameAsSequential) {
+    for (size_t initial : {0, 1, 60, 16380}) {
+      for (size_t count : {0, 1, 4, 100}) {
+        Values values(initial, 7);
+        auto sequential =
+            initial == 0 ? ByteArray{} : scale::encode(values).value();
+        auto batched = sequential;
+
+        std::vector<ByteArray> items;
+        for (size_t i = 0; i < count; ++i) {
+          items.push_back(scale::encode(static_cast<int>(i)).value());
+          EXPECT_FALSE(
+              append_or_new_vec(sequential, items.back()).has_error());
+        }
+        std::vector<ConstSpanOfBytes> inputs(items.begin(), items.end());
+        EXPECT_FALSE(append_many(batched, inputs).has_error());
+        EXPECT_EQ(batched, sequential) << initial << " + " << count;
+      }
+    }
+  }
+
+  /**
+   * @given data which is not an encoded vector
+   * @when items are appended to it
+   * @then error is returned
+   */
+  TEST(EncodeAppend, AppendManyError) {
+    ByteArray out{0b11};
+    auto item = scale::encode(1).value();
+    std::vector<ConstSpanOfBytes> inputs{item};
+    EXPECT_TRUE(append_many(out, inputs).has_error());
+  }
+
+  /**
+   * @given encoded vector of the max length
+   * @when an item is appended to it
+   * @then TOO_MANY_ITEMS error is returned instead of the length wrapped
+   * around, the vector is not changed
+   */
+  TEST(EncodeAppend, AppendManyLengthOverflow) {
+    ByteArray out{0x13, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff};
+    const auto original = out;
+    auto item = scale::encode(1).value();
+    std::vector<ConstSpanOfBytes> inputs{item};
+    EXPECT_EC(append_many(out, inputs), DecodeError::TOO_MANY_ITEMS);
+    EXPECT_EQ(out, original);
+  }
+
+  /**
+   * @given vector, which length prefix gets longer while items are appended
+   * @when items are appended to AppendableEncodedVec
+   * @then encoded vector is the same as made by append_or_new_vec
+   */
+  TEST(AppendableEncodedVec, SameAsAppendOrNewVec) {
+    AppendableEncodedVec vec;
+    EXPECT_EQ(ByteArray(vec.encoded().begin(), vec.encoded().end()),
+              scale::encode(Values{}).value());
+
+    ByteArray expected;
+    for (int i = 0; i < 20000; ++i) {
+      auto item = scale::encode(i).value();
+      vec.append(item);
+      EXPECT_FALSE(append_or_new_vec(expected, item).has_error());
+      if (i == 62 or i == 63 or i == 16383) {
+        EXPECT_EQ(ByteArray(vec.encoded().begin(), vec.encoded().end()),
+                  expected);
+      }
+    }
+    EXPECT_EQ(vec.size(), 20000);
+    EXPECT_EQ(scale::encode(vec).value(), expected);
+    EXPECT_EQ(vec.take(), expected);
+    EXPECT_EQ(vec.size(), 0);
+  }
+
+  /**
+   * @given vector encoded by append_or_new_vec
+   * @when it is continued by AppendableEncodedVec
+   * @then the result is the same as of continuing by append_or_new_vec
+   */
+  TEST(AppendableEncodedVec, FromEncoded) {
+    Values values{1, 2, 3};
+    auto expected = scale::encode(values).value();
+    EXPECT_OUTCOME_TRUE(vec, AppendableEncodedVec::fromEncoded(expected));
+    EXPECT_EQ(vec.size(), 3);
+
+    std::vector<ByteArray> items{scale::encode(4).value(),
+                                 scale::encode(5).value()};
+    std::vector<ConstSpanOfBytes> inputs(items.begin(), items.end());
+    vec.append(inputs);
+    EXPECT_FALSE(append_many(expected, inputs).has_error());
+    EXPECT_EQ(vec.take(), expected);
+
+    EXPECT_TRUE(AppendableEncodedVec::fromEncoded(ByteArray{0b11}).has_error());
+  }
 }  // namespace scale
@@ -9,8 +9,11 @@
 #include <optional>
 #include <string>
 
+#include <scale/scale_encode_counter.hpp>
 #include <scale/scale_encoder_stream.hpp>
 
+using scale::CompactInteger;
+using scale::ScaleEncodeCounter;
 using scale::ScaleEncoderStream;
 
 class ScaleCounter : public ::testing::Test {
@@ -87,3 +90,43 @@ TEST_F(ScaleCounter, CustomStruct) {
   s << st;
   SIZE(1 + st.y.size() + 1);
 }
+
+class ScaleEncodeCounterTest : public ::testing::Test {
+ protected:
+  template <typename... Args>
+  static void expectSameSize(const Args &...args) {
+    ScaleEncoderStream encoder;
+    (encoder << ... << args);
+    ScaleEncodeCounter counter;
+    (counter << ... << args);
+    ASSERT_EQ(counter.size(), encoder.size());
+  }
+};
+
+/**
+ * @given values of various types
+ * @when they get counted by ScaleEncodeCounter
+ * @then the resulting size equals to size of the encoded data
+ */
+TEST_F(ScaleEncodeCounterTest, SameSizeAsEncoded) {
+  expectSameSize(true, uint8_t{1}, uint64_t{2}, CompactInteger{1u << 20});
+  expectSameSize(std::string("test string"), std::optional<uint32_t>{10});
+  expectSameSize(std::vector<uint32_t>(100), std::array<int16_t, 3>{});
+  expectSameSize(std::vector<bool>(100), std::vector<std::string>{"a", "bc"});
+  expectSameSize(std::tuple<uint8_t, std::string>{1, "test string"});
+  expectSameSize(scale::BitVec{true, false, true});
+  expectSameSize(TestStruct{.x = 10, .y = "test string"});
+}
+
+/**
+ * @given a very large collection of fixed-width elements
+ * @when it gets counted by ScaleEncodeCounter
+ * @then the resulting size is computed without visiting the elements
+ */
+TEST_F(ScaleEncodeCounterTest, LargeCollection) {
+  std::vector<bool> flags(1 << 20);
+  std::vector<uint64_t> values(1 << 20);
+  ScaleEncodeCounter counter;
+  counter << flags << values;
+  ASSERT_EQ(counter.size(), (4 + flags.size()) + (4 + values.size() * 8));
+}
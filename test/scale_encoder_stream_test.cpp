@@ -0,0 +1,78 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+
+#include "scale/scale_encoder_stream.hpp"
+#include "scale/types.hpp"
+
+using scale::ByteArray;
+using scale::ScaleEncoderStream;
+
+/**
+ * @given stream with some encoded data
+ * @when take() is called
+ * @then encoded data is moved out and the stream becomes empty
+ */
+TEST(ScaleEncoderStreamTest, TakeTest) {
+  ScaleEncoderStream s;
+  s << uint32_t{0x04030201} << std::string("ab");
+  auto expected = ByteArray{1, 2, 3, 4, 8, 'a', 'b'};
+  ASSERT_EQ(s.to_vector(), expected);
+  ASSERT_EQ(s.size(), expected.size());
+
+  ASSERT_EQ(s.take(), expected);
+  ASSERT_EQ(s.size(), 0);
+  ASSERT_TRUE(s.to_vector().empty());
+
+  s << uint8_t{5};
+  ASSERT_EQ(s.take(), ByteArray{5});
+}
+
+/**
+ * @given stream with reserved space
+ * @when data of various sizes is encoded
+ * @then encoded data is the same as without reservation
+ */
+TEST(ScaleEncoderStreamTest, ReserveTest) {
+  std::vector<uint16_t> value(1000, 0xABCD);
+
+  ScaleEncoderStream plain;
+  plain << value;
+
+  ScaleEncoderStream reserved;
+  reserved.reserve(16);
+  reserved << value;
+
+  ASSERT_EQ(reserved.size(), plain.size());
+  ASSERT_EQ(reserved.to_vector(), plain.to_vector());
+}
+
+/**
+ * @given stream which only counts encoded data
+ * @when data is encoded and reservation is requested
+ * @then size is tracked but no data is kept
+ */
+TEST(ScaleEncoderStreamTest, DropDataTest) {
+  ScaleEncoderStream s{true};
+  s.reserve(100);
+  s << uint64_t{1};
+  ASSERT_EQ(s.size(), 8);
+  ASSERT_TRUE(s.take().empty());
+  ASSERT_EQ(s.size(), 0);
+}
+
+/**
+ * @given stream which does not throw on errors
+ * @when null pointer is encoded
+ * @then error is kept in the stream state
+ */
+TEST(ScaleEncoderStreamTest, ErrorStateTest) {
+  ScaleEncoderStream s;
+  s.setThrowOnError(false);
+  ASSERT_NO_THROW(s << std::shared_ptr<uint8_t>{} << uint8_t{1});
+  ASSERT_EQ(s.error(), scale::EncodeError::DEREF_NULLPOINTER);
+}
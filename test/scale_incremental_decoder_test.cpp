@@ -0,0 +1,208 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+
+#include "scale/incremental_decoder.hpp"
+#include "util/outcome.hpp"
+
+using scale::ByteArray;
+using scale::ConstSpanOfBytes;
+using scale::DecodeError;
+using scale::encode;
+using scale::IncrementalDecoder;
+
+using Message = std::vector<std::pair<std::string, std::vector<uint32_t>>>;
+
+namespace {
+  /// number of decoded or skipped Counted items
+  size_t counted_items = 0;
+
+  /// item, which counts its decoding
+  struct Counted {
+    ByteArray bytes;
+
+    bool operator==(const Counted &other) const = default;
+  };
+
+  scale::ScaleDecoderStream &operator>>(scale::ScaleDecoderStream &s,
+                                        Counted &v) {
+    ++counted_items;
+    return s >> v.bytes;
+  }
+}  // namespace
+
+/**
+ * @given encoded message split to chunks of various sizes
+ * @when chunks are fed to incremental decoder one by one
+ * @then missing bytes are reported until the last chunk, after which the
+ * message is decoded
+ */
+TEST(IncrementalDecoder, ChunkedInput) {
+  Message message{{"first", {1, 2, 3}},
+                  {std::string(300, 'x'), {}},
+                  {"third", std::vector<uint32_t>(50, 7)}};
+  EXPECT_OUTCOME_TRUE(encoded, encode(message));
+
+  for (size_t chunk_size : {1, 2, 7, 100, 1000}) {
+    IncrementalDecoder<Message> decoder;
+    ConstSpanOfBytes data{encoded};
+    size_t missing = 0;
+    while (not data.empty()) {
+      ASSERT_FALSE(decoder.done());
+      auto chunk = data.first(std::min(chunk_size, data.size()));
+      data = data.subspan(chunk.size());
+      EXPECT_OUTCOME_TRUE(result, decoder.feed(chunk));
+      missing = result;
+      // missing bytes are never overestimated
+      EXPECT_LE(missing, data.size());
+    }
+    EXPECT_EQ(missing, 0);
+    ASSERT_TRUE(decoder.done());
+    EXPECT_EQ(decoder.take(), message);
+    EXPECT_TRUE(decoder.remaining().empty());
+  }
+}
+
+/**
+ * @given incremental decoder of byte array
+ * @when its length prefix is fed
+ * @then exact number of missing bytes is reported
+ */
+TEST(IncrementalDecoder, ReportsMissingBytes) {
+  ByteArray bytes(1000, 0xAB);
+  EXPECT_OUTCOME_TRUE(encoded, encode(bytes));
+  ConstSpanOfBytes data{encoded};
+
+  IncrementalDecoder<ByteArray> decoder;
+  EXPECT_OUTCOME_TRUE(missing, decoder.feed(data.first(1)));
+  EXPECT_EQ(missing, 1);
+  EXPECT_OUTCOME_TRUE(missing2, decoder.feed(data.subspan(1, 11)));
+  EXPECT_EQ(missing2, 990);
+  EXPECT_OUTCOME_TRUE(missing3, decoder.feed(data.subspan(12, 900)));
+  EXPECT_EQ(missing3, 90);
+  EXPECT_OUTCOME_TRUE(missing4, decoder.feed(data.subspan(912)));
+  EXPECT_EQ(missing4, 0);
+  EXPECT_EQ(decoder.take(), bytes);
+}
+
+/**
+ * @given several encoded messages in one chunk
+ * @when the chunk is fed
+ * @then messages are decoded one after another from remaining data
+ */
+TEST(IncrementalDecoder, ConsecutiveMessages) {
+  EXPECT_OUTCOME_TRUE(encoded,
+                      encode(uint32_t{1}, uint32_t{2}, uint16_t{3}));
+  IncrementalDecoder<uint32_t> decoder;
+  EXPECT_OUTCOME_TRUE(missing, decoder.feed(encoded));
+  EXPECT_EQ(missing, 0);
+  EXPECT_EQ(decoder.take(), 1);
+  EXPECT_EQ(decoder.remaining().size(), 6);
+  EXPECT_OUTCOME_TRUE(missing2, decoder.feed({}));
+  EXPECT_EQ(missing2, 0);
+  EXPECT_EQ(decoder.take(), 2);
+  EXPECT_OUTCOME_TRUE(missing3, decoder.feed({}));
+  EXPECT_EQ(missing3, 2);
+}
+
+/**
+ * @given malformed data
+ * @when it is fed to incremental decoder
+ * @then decoding error is returned
+ */
+TEST(IncrementalDecoder, MalformedData) {
+  IncrementalDecoder<std::optional<bool>> decoder;
+  EXPECT_EC(decoder.feed(ByteArray{3}), DecodeError::UNEXPECTED_VALUE);
+}
+
+/**
+ * @given data, which ends in the middle of a value detected not by its own
+ * length check
+ * @when it is fed to incremental decoder
+ * @then exact number of missing bytes is reported
+ */
+TEST(IncrementalDecoder, MissingBytesInRange) {
+  ByteArray encoded{8, 1, 0, 0, 0, 2, 0, 0, 0};
+  ConstSpanOfBytes data{encoded};
+  IncrementalDecoder<std::tuple<std::vector<uint32_t>>> decoder;
+  EXPECT_OUTCOME_TRUE(missing, decoder.feed(data.first(4)));
+  EXPECT_EQ(missing, 5);
+  EXPECT_OUTCOME_TRUE(missing2, decoder.feed(data.subspan(4)));
+  EXPECT_EQ(missing2, 0);
+  ASSERT_TRUE(decoder.done());
+  EXPECT_EQ(decoder.take(), (std::tuple{std::vector<uint32_t>{1, 2}}));
+}
+
+/**
+ * @given types, which decoded values keep views into decoded data
+ * @when they are checked for being decodable incrementally
+ * @then they are rejected, while owning types are not
+ */
+TEST(IncrementalDecoder, RejectsViews) {
+  static_assert(scale::kHoldsView<scale::LazyVec<uint32_t>>);
+  static_assert(scale::kHoldsView<std::string_view>);
+  static_assert(scale::kHoldsView<ConstSpanOfBytes>);
+  static_assert(
+      scale::kHoldsView<std::vector<std::optional<std::string_view>>>);
+  static_assert(
+      scale::kHoldsView<std::tuple<uint8_t, scale::LazyVec<uint8_t>>>);
+  static_assert(not scale::kHoldsView<Message>);
+  static_assert(not scale::kHoldsView<ByteArray>);
+}
+
+/**
+ * @given compact integers of all the encoding modes
+ * @when their encoding is split into two fragments at every point
+ * @then exact number of missing bytes is reported after the first fragment,
+ * and the value is decoded after the second one
+ */
+TEST(IncrementalDecoder, SplitCompactInteger) {
+  scale::CompactInteger big = 1;
+  big <<= 200;
+  for (scale::CompactInteger value :
+       {scale::CompactInteger{1u << 10}, scale::CompactInteger{1u << 20},
+        scale::CompactInteger{uint64_t{1} << 40}, big}) {
+    EXPECT_OUTCOME_TRUE(encoded, encode(value));
+    ConstSpanOfBytes data{encoded};
+    for (size_t split = 1; split < encoded.size(); ++split) {
+      IncrementalDecoder<scale::CompactInteger> decoder;
+      EXPECT_OUTCOME_TRUE(missing, decoder.feed(data.first(split)));
+      EXPECT_EQ(missing, encoded.size() - split) << value << " " << split;
+      EXPECT_OUTCOME_TRUE(missing2, decoder.feed(data.subspan(split)));
+      EXPECT_EQ(missing2, 0);
+      EXPECT_EQ(decoder.take(), value);
+    }
+  }
+}
+
+/**
+ * @given encoded collection nested in optional and tuple
+ * @when its encoding is fed byte by byte
+ * @then passed items are not rescanned, so each item is passed a constant
+ * number of times
+ */
+TEST(IncrementalDecoder, NestedCollectionNotRescanned) {
+  using Nested = std::tuple<uint8_t, std::optional<std::vector<Counted>>>;
+  constexpr size_t kItems = 1000;
+  const ByteArray bytes{1, 2, 3};
+  Nested value{1, std::vector<Counted>(kItems, Counted{bytes})};
+  ByteArray encoded{1, 1};
+  EXPECT_OUTCOME_TRUE(items, encode(std::vector<ByteArray>(kItems, bytes)));
+  encoded.insert(encoded.end(), items.begin(), items.end());
+
+  counted_items = 0;
+  IncrementalDecoder<Nested> decoder;
+  for (auto byte : encoded) {
+    ASSERT_FALSE(decoder.done());
+    ASSERT_TRUE(decoder.feed(ConstSpanOfBytes{&byte, 1}).has_value());
+  }
+  ASSERT_TRUE(decoder.done());
+  EXPECT_EQ(decoder.take(), value);
+  // each item is passed once and decoded once, besides that at most one
+  // incomplete item is tried per fed byte
+  EXPECT_LE(counted_items, 2 * kItems + encoded.size());
+}
@@ -0,0 +1,169 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+
+#include "scale/scale.hpp"
+#include "util/outcome.hpp"
+
+using scale::ByteArray;
+using scale::decode;
+using scale::decodeBorrowed;
+using scale::DecodeError;
+using scale::encode;
+using scale::LazyVec;
+
+/**
+ * @given encoded vector of strings followed by other data
+ * @when it is decoded as LazyVec
+ * @then items are decoded by random access and iteration, stream is
+ * advanced over the whole vector
+ */
+TEST(LazyVec, DynamicSizeItems) {
+  std::vector<std::string> items{"zero", "", "two", std::string(100, 'x')};
+  EXPECT_OUTCOME_TRUE(encoded, encode(items, uint16_t{0xBEEF}));
+
+  scale::ScaleDecoderStream s(encoded, scale::kBorrowInput);
+  LazyVec<std::string> lazy;
+  uint16_t tail = 0;
+  s >> lazy >> tail;
+  EXPECT_EQ(tail, 0xBEEF);
+
+  ASSERT_EQ(lazy.size(), items.size());
+  EXPECT_EQ(lazy[3], items[3]);
+  EXPECT_EQ(lazy[1], items[1]);
+  EXPECT_EQ(lazy.at(0), items[0]);
+  EXPECT_THROW(lazy.at(4), std::out_of_range);
+
+  std::vector<std::string> iterated;
+  for (auto &&item : lazy) {
+    iterated.push_back(item);
+  }
+  EXPECT_EQ(iterated, items);
+
+  // iteration without dereferencing skips items
+  auto it = lazy.begin();
+  ++it;
+  ++it;
+  EXPECT_EQ(*it, items[2]);
+}
+
+/**
+ * @given encoded vector of fixed size items
+ * @when it is decoded as LazyVec and encoded back
+ * @then items are accessible and encoding is the same
+ */
+TEST(LazyVec, StaticSizeItemsRoundTrip) {
+  using Item = std::pair<uint32_t, uint8_t>;
+  std::vector<Item> items{{1, 2}, {3, 4}, {5, 6}};
+  EXPECT_OUTCOME_TRUE(encoded, encode(items));
+  EXPECT_OUTCOME_TRUE(lazy, decodeBorrowed<LazyVec<Item>>(encoded));
+  EXPECT_EQ(lazy.encodedItems().size(), 15);
+  EXPECT_EQ(lazy[2], items[2]);
+  EXPECT_OUTCOME_TRUE(reencoded, encode(lazy));
+  EXPECT_EQ(reencoded, encoded);
+}
+
+/**
+ * @given truncated encoded vector
+ * @when it is decoded as LazyVec
+ * @then NOT_ENOUGH_DATA error is returned
+ */
+TEST(LazyVec, TruncatedData) {
+  std::vector<ByteArray> items{{1, 2, 3}, {4, 5}};
+  EXPECT_OUTCOME_TRUE(encoded, encode(items));
+  encoded.pop_back();
+  EXPECT_EC(decodeBorrowed<LazyVec<ByteArray>>(encoded),
+            DecodeError::NOT_ENOUGH_DATA);
+}
+
+/**
+ * @given encoded vectors with invalid bool values among the items
+ * @when they are decoded as LazyVec
+ * @then decoding fails with UNEXPECTED_VALUE instead of failing on access
+ */
+TEST(LazyVec, InvalidItems) {
+  ByteArray bools{12, 1, 0, 2};
+  EXPECT_EC(decodeBorrowed<LazyVec<bool>>(bools),
+            DecodeError::UNEXPECTED_VALUE);
+
+  using Pair = std::pair<uint8_t, bool>;
+  ByteArray pairs{8, 7, 1, 8, 3};
+  EXPECT_EC(decodeBorrowed<LazyVec<Pair>>(pairs),
+            DecodeError::UNEXPECTED_VALUE);
+
+  ByteArray nested{8, 4, 1, 8, 0, 5};
+  EXPECT_EC(decodeBorrowed<LazyVec<std::vector<bool>>>(nested),
+            DecodeError::UNEXPECTED_VALUE);
+  EXPECT_EC(scale::encodedLength<std::vector<std::vector<bool>>>(nested),
+            DecodeError::UNEXPECTED_VALUE);
+
+  nested.back() = 1;
+  EXPECT_OUTCOME_TRUE(valid,
+                      decodeBorrowed<LazyVec<std::vector<bool>>>(nested));
+  EXPECT_EQ(valid[1], (std::vector<bool>{false, true}));
+}
+
+/**
+ * @given vector of byte vectors made by append_or_new_vec
+ * @when it is decoded by decodeBorrowed as LazyVec of byte views
+ * @then items are views into the encoded data, by iteration and by index,
+ * encoded items are available for decoding as other types
+ */
+TEST(LazyVec, BorrowedByteVectors) {
+  std::vector<ByteArray> events{{1, 2, 3}, {}, ByteArray(100, 7), {4}};
+  ByteArray encoded;
+  for (auto &event : events) {
+    EXPECT_OUTCOME_TRUE(item, encode(event));
+    EXPECT_FALSE(scale::append_or_new_vec(encoded, item).has_error());
+  }
+
+  using View = LazyVec<scale::ConstSpanOfBytes>;
+  EXPECT_OUTCOME_TRUE(view, decodeBorrowed<View>(encoded));
+  ASSERT_EQ(view.size(), events.size());
+  auto in_data = [&](scale::ConstSpanOfBytes item) {
+    return item.empty()
+        or (item.data() >= encoded.data()
+            and item.data() + item.size() <= encoded.data() + encoded.size());
+  };
+
+  size_t i = 0;
+  for (auto it = view.begin(); it != view.end(); ++it, ++i) {
+    auto item = *it;
+    EXPECT_TRUE(in_data(item));
+    EXPECT_EQ(ByteArray(item.begin(), item.end()), events[i]);
+    EXPECT_OUTCOME_TRUE(decoded, decode<ByteArray>(it.encoded()));
+    EXPECT_EQ(decoded, events[i]);
+  }
+  EXPECT_EQ(i, events.size());
+
+  auto third = view[2];
+  EXPECT_EQ(ByteArray(third.begin(), third.end()), events[2]);
+  EXPECT_OUTCOME_TRUE(first, decode<ByteArray>(view.encodedItem(0)));
+  EXPECT_EQ(first, events[0]);
+  EXPECT_OUTCOME_TRUE(last, decode<ByteArray>(view.encodedItem(3)));
+  EXPECT_EQ(last, events[3]);
+}
+
+/**
+ * @given encoded vectors
+ * @when they are decoded as LazyVec by non-borrowing stream
+ * @then BORROWING_NOT_ALLOWED error is returned, as the views would outlive
+ * the data
+ */
+TEST(LazyVec, NotBorrowingStream) {
+  EXPECT_OUTCOME_TRUE(encoded, encode(std::vector<std::string>{"a", "b"}));
+  EXPECT_EC(decode<LazyVec<std::string>>(encoded),
+            DecodeError::BORROWING_NOT_ALLOWED);
+
+  EXPECT_OUTCOME_TRUE(bytes, encode(std::vector<ByteArray>{{1}, {2, 3}}));
+  EXPECT_EC(decode<LazyVec<scale::ConstSpanOfBytes>>(bytes),
+            DecodeError::BORROWING_NOT_ALLOWED);
+
+  // encoded length is still found without borrowing
+  EXPECT_OUTCOME_TRUE(length, scale::encodedLength<LazyVec<ByteArray>>(bytes));
+  EXPECT_EQ(length, bytes.size());
+}
@@ -221,3 +221,33 @@ TEST(Scale, DecodeNullopt) {
   EXPECT_OUTCOME_TRUE(tuple_opt, decode<OptionalTuple>(encoded_nullopt));
   EXPECT_EQ(tuple_opt, std::nullopt);
 }
+
+/**
+ * @brief helper struct, which can be neither copied nor moved
+ */
+struct Pinned {
+  Pinned() = default;
+  Pinned(const Pinned &) = delete;
+  Pinned &operator=(const Pinned &) = delete;
+
+  uint16_t value = 0;
+};
+
+template <class Stream, typename = std::enable_if_t<Stream::is_decoder_stream>>
+Stream &operator>>(Stream &s, Pinned &v) {
+  return s >> v.value;
+}
+
+/**
+ * @given byte array with encoded optional value of non-movable type
+ * @when it is decoded by decoder stream
+ * @then the value is constructed in place and decoded
+ */
+TEST(Scale, DecodeOptionalNonMovable) {
+  ByteArray bytes{1, 0x34, 0x12};
+  ScaleDecoderStream s{bytes};
+  std::optional<Pinned> v;
+  ASSERT_NO_THROW((s >> v));
+  ASSERT_TRUE(v.has_value());
+  EXPECT_EQ(v->value, 0x1234);
+}
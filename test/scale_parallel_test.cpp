@@ -0,0 +1,192 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+
+#include "scale/parallel.hpp"
+#include "util/outcome.hpp"
+
+using scale::ByteArray;
+using scale::decode;
+using scale::DecodeError;
+using scale::decodeParallel;
+using scale::encode;
+using scale::EncodeError;
+using scale::encodeParallel;
+
+namespace {
+  using Entry = std::pair<std::string, std::optional<ByteArray>>;
+
+  std::vector<Entry> makeEntries(size_t n) {
+    std::vector<Entry> entries(n);
+    for (size_t i = 0; i < n; ++i) {
+      entries[i].first = std::string(i % 50, static_cast<char>('a' + i % 26));
+      if (i % 3 != 0) {
+        entries[i].second = ByteArray(i % 70, static_cast<uint8_t>(i));
+      }
+    }
+    return entries;
+  }
+
+  /// item, which decoding throws other exception than stream errors
+  struct Throwing {
+    uint8_t value = 0;
+  };
+
+  scale::ScaleDecoderStream &operator>>(scale::ScaleDecoderStream &s,
+                                        Throwing &v) {
+    s >> v.value;
+    if (v.value == 7) {
+      throw std::runtime_error("unexpected item");
+    }
+    return s;
+  }
+
+  /// item too big to allocate memory for many of them
+  struct Huge {
+    std::array<uint8_t, size_t{1} << 40> bytes;
+  };
+
+  scale::ScaleDecoderStream &operator>>(scale::ScaleDecoderStream &s,
+                                        Huge &v) {
+    return s >> v.bytes[0];
+  }
+}  // namespace
+
+template <>
+struct scale::static_encoded_size<Throwing>
+    : std::integral_constant<size_t, 1> {};
+
+template <>
+struct scale::static_encoded_size<Huge> : std::integral_constant<size_t, 1> {
+};
+
+/**
+ * @given encoded vector of variable size items
+ * @when it is decoded on different numbers of threads
+ * @then result is the same as of sequential decoding
+ */
+TEST(DecodeParallel, SameAsSequential) {
+  auto entries = makeEntries(10000);
+  EXPECT_OUTCOME_TRUE(encoded, encode(entries));
+
+  for (size_t threads : {1, 2, 3, 8, 0}) {
+    EXPECT_OUTCOME_TRUE(decoded, decodeParallel<Entry>(encoded, threads));
+    EXPECT_EQ(decoded, entries) << threads << " threads";
+  }
+}
+
+/**
+ * @given encoded vectors of fixed size items of different lengths
+ * @when they are decoded on several threads
+ * @then result is the same as of sequential decoding
+ */
+TEST(DecodeParallel, StaticSizeItems) {
+  for (size_t n : {0, 1, 63, 64, 65, 1000, 4099}) {
+    std::vector<std::pair<uint32_t, uint16_t>> items(n);
+    for (size_t i = 0; i < n; ++i) {
+      items[i] = {static_cast<uint32_t>(i * 7), static_cast<uint16_t>(i)};
+    }
+    EXPECT_OUTCOME_TRUE(encoded, encode(items));
+    EXPECT_OUTCOME_TRUE(decoded,
+                        (decodeParallel<std::pair<uint32_t, uint16_t>>(
+                            encoded, 4)));
+    EXPECT_EQ(decoded, items) << n << " items";
+  }
+}
+
+/**
+ * @given truncated or corrupted encoded vector
+ * @when it is decoded on several threads
+ * @then the error is the same as of sequential decoding
+ */
+TEST(DecodeParallel, Errors) {
+  EXPECT_OUTCOME_TRUE(encoded, encode(makeEntries(1000)));
+
+  auto truncated = encoded;
+  truncated.resize(encoded.size() - 1);
+  EXPECT_EC(decodeParallel<Entry>(truncated, 4), DecodeError::NOT_ENOUGH_DATA);
+
+  // option flag of the first entry, which is an empty string
+  auto corrupted = encoded;
+  corrupted[3] = 2;
+  using Entries = std::vector<Entry>;
+  EXPECT_EC(decode<Entries>(corrupted), DecodeError::UNEXPECTED_VALUE);
+  EXPECT_EC(decodeParallel<Entry>(corrupted, 4), DecodeError::UNEXPECTED_VALUE);
+
+  ByteArray too_long{0x0b, 0, 0, 0, 0, 0, 0x01, 0, 0};
+  EXPECT_EC(decodeParallel<uint32_t>(too_long, 4),
+            DecodeError::NOT_ENOUGH_DATA);
+}
+
+/**
+ * @given encoded vector, which item decoding throws other exception than
+ * stream errors
+ * @when it is decoded on several threads
+ * @then the exception is rethrown on the calling thread
+ */
+TEST(DecodeParallel, ItemThrows) {
+  ByteArray values(1000, 1);
+  values[500] = 7;
+  EXPECT_OUTCOME_TRUE(encoded, encode(values));
+  EXPECT_THROW(decodeParallel<Throwing>(encoded, 4), std::runtime_error);
+}
+
+/**
+ * @given encoded vector of items too big to allocate all of them
+ * @when it is decoded
+ * @then TOO_MANY_ITEMS error is returned
+ */
+TEST(DecodeParallel, TooManyItems) {
+  EXPECT_OUTCOME_TRUE(encoded, encode(ByteArray(1000, 1)));
+  EXPECT_EC(decodeParallel<Huge>(encoded, 4), DecodeError::TOO_MANY_ITEMS);
+}
+
+/**
+ * @given vector of variable size items
+ * @when it is encoded on different numbers of threads
+ * @then result is the same as of sequential encoding
+ */
+TEST(EncodeParallel, SameAsSequential) {
+  for (size_t n : {0, 1, 65, 10000}) {
+    auto entries = makeEntries(n);
+    EXPECT_OUTCOME_TRUE(expected, encode(entries));
+    for (size_t threads : {1, 2, 3, 8, 0}) {
+      EXPECT_OUTCOME_TRUE(encoded, encodeParallel(entries, threads));
+      EXPECT_EQ(encoded, expected) << n << " items, " << threads << " threads";
+    }
+  }
+}
+
+/**
+ * @given vector of fixed size items
+ * @when it is encoded on several threads
+ * @then result is the same as of sequential encoding
+ */
+TEST(EncodeParallel, StaticSizeItems) {
+  std::vector<uint64_t> items(4099);
+  for (size_t i = 0; i < items.size(); ++i) {
+    items[i] = i * 0x0101010101;
+  }
+  EXPECT_OUTCOME_TRUE(expected, encode(items));
+  EXPECT_OUTCOME_TRUE(encoded, encodeParallel(items, 4));
+  EXPECT_EQ(encoded, expected);
+}
+
+/**
+ * @given vector of items, one of which can not be encoded
+ * @when it is encoded on several threads
+ * @then the error is the same as of sequential encoding
+ */
+TEST(EncodeParallel, Error) {
+  std::vector<std::shared_ptr<uint32_t>> items(1000);
+  for (auto &item : items) {
+    item = std::make_shared<uint32_t>(1);
+  }
+  items[700].reset();
+  EXPECT_EC(encode(items), EncodeError::DEREF_NULLPOINTER);
+  EXPECT_EC(encodeParallel(items, 4), EncodeError::DEREF_NULLPOINTER);
+}
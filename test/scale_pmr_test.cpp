@@ -0,0 +1,140 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <memory_resource>
+
+#include "scale/scale.hpp"
+#include "util/outcome.hpp"
+
+using scale::decode;
+using scale::encode;
+
+namespace {
+  /// Memory resource counting allocations made through it
+  class CountingResource : public std::pmr::memory_resource {
+   public:
+    size_t allocations = 0;
+
+   private:
+    void *do_allocate(size_t bytes, size_t alignment) override {
+      ++allocations;
+      return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+    void do_deallocate(void *p, size_t bytes, size_t alignment) override {
+      std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+    bool do_is_equal(const memory_resource &other) const noexcept override {
+      return this == &other;
+    }
+  };
+
+  /// Sets default memory resource for its lifetime
+  class DefaultResourceGuard {
+   public:
+    explicit DefaultResourceGuard(std::pmr::memory_resource *resource)
+        : previous_{std::pmr::set_default_resource(resource)} {}
+    ~DefaultResourceGuard() {
+      std::pmr::set_default_resource(previous_);
+    }
+
+   private:
+    std::pmr::memory_resource *previous_;
+  };
+
+  const std::string kLong(100, 'l');
+  const std::string_view kLongView{kLong};
+}  // namespace
+
+/// Allocator-aware structure, which passes allocator to its members
+struct Block {
+  using allocator_type = std::pmr::polymorphic_allocator<>;
+
+  Block() = default;
+  explicit Block(const allocator_type &allocator)
+      : extrinsics{allocator}, digest{allocator} {}
+  Block(Block &&other, const allocator_type &allocator)
+      : number{other.number},
+        extrinsics{std::move(other.extrinsics), allocator},
+        digest{std::move(other.digest), allocator} {}
+  Block(Block &&) = default;
+  Block &operator=(Block &&) = default;
+
+  uint32_t number = 0;
+  std::pmr::vector<std::pmr::vector<uint8_t>> extrinsics;
+  std::pmr::map<uint32_t, std::pmr::string> digest;
+};
+
+template <class Stream, typename = std::enable_if_t<Stream::is_encoder_stream>>
+Stream &operator<<(Stream &s, const Block &v) {
+  return s << v.number << v.extrinsics << v.digest;
+}
+
+template <class Stream, typename = std::enable_if_t<Stream::is_decoder_stream>>
+Stream &operator>>(Stream &s, Block &v) {
+  return s >> v.number >> v.extrinsics >> v.digest;
+}
+
+/**
+ * @given encoded nested pmr containers
+ * @when they are decoded with memory resource
+ * @then all the memory is allocated from the resource, but not from default
+ * one
+ */
+TEST(PmrDecode, NestedContainersUseResource) {
+  using Value =
+      std::tuple<std::pmr::vector<std::pmr::string>,
+                 std::pmr::map<uint32_t, std::pmr::vector<uint32_t>>,
+                 std::optional<std::pmr::string>,
+                 std::shared_ptr<std::pmr::string>,
+                 std::pmr::vector<Block>>;
+  Block block;
+  block.number = 5;
+  block.extrinsics.emplace_back(100, 1);
+  block.digest.emplace(1, kLong);
+  std::vector<Block> blocks;
+  blocks.push_back(std::move(block));
+  EXPECT_OUTCOME_TRUE(
+      encoded,
+      encode(std::vector<std::string>{kLong, kLong},
+             std::map<uint32_t, std::vector<uint32_t>>{{1, {1, 2, 3}}},
+             std::optional<std::string>{kLong},
+             std::make_shared<std::string>(kLong),
+             blocks));
+
+  CountingResource arena;
+  CountingResource fallback;
+  DefaultResourceGuard guard{&fallback};
+  EXPECT_OUTCOME_TRUE(decoded, decode<Value>(encoded, &arena));
+
+  EXPECT_EQ(std::get<0>(decoded)[1], kLongView);
+  EXPECT_EQ(std::get<1>(decoded).at(1).size(), 3);
+  EXPECT_EQ(*std::get<2>(decoded), kLongView);
+  EXPECT_EQ(*std::get<3>(decoded), kLongView);
+  EXPECT_EQ(std::get<4>(decoded)[0].digest.at(1), kLongView);
+  EXPECT_EQ(std::get<4>(decoded)[0].extrinsics[0].size(), 100);
+  EXPECT_EQ(std::get<4>(decoded)[0].digest.get_allocator().resource(),
+            &arena);
+  EXPECT_GT(arena.allocations, 0);
+  EXPECT_EQ(fallback.allocations, 0);
+}
+
+/**
+ * @given encoded pmr container
+ * @when it is decoded without memory resource
+ * @then default memory resource is used
+ */
+TEST(PmrDecode, DefaultResourceWithoutArena) {
+  EXPECT_OUTCOME_TRUE(encoded, encode(std::vector<std::string>{kLong}));
+  CountingResource fallback;
+  DefaultResourceGuard guard{&fallback};
+  EXPECT_OUTCOME_TRUE(decoded,
+                      decode<std::pmr::vector<std::pmr::string>>(encoded));
+  EXPECT_EQ(decoded[0], kLongView);
+  EXPECT_GT(fallback.allocations, 0);
+}
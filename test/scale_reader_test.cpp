@@ -0,0 +1,206 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#include <gtest/gtest.h>
+
+#include "scale/mapped_file.hpp"
+#include "scale/scale_reader.hpp"
+#include "util/outcome.hpp"
+
+using scale::ByteArray;
+using scale::ByteSource;
+using scale::DecodeError;
+using scale::MappedFile;
+using scale::ScaleReader;
+
+namespace {
+  using Entry = std::pair<std::string, std::vector<uint32_t>>;
+
+  std::vector<Entry> makeEntries() {
+    std::vector<Entry> entries;
+    for (uint32_t i = 0; i < 50; ++i) {
+      entries.emplace_back(std::string(i, 'e'), std::vector<uint32_t>(i, i));
+    }
+    return entries;
+  }
+
+  /// stream buffer, which gets data in pieces, like a pipe does
+  class PieceBuffer : public std::streambuf {
+   public:
+    explicit PieceBuffer(std::vector<std::string> pieces)
+        : pieces_{std::move(pieces)} {}
+
+   protected:
+    int_type underflow() override {
+      if (next_ == pieces_.size()) {
+        return traits_type::eof();
+      }
+      auto &piece = pieces_[next_++];
+      setg(piece.data(), piece.data(), piece.data() + piece.size());
+      return traits_type::to_int_type(piece.front());
+    }
+
+   private:
+    std::vector<std::string> pieces_;
+    size_t next_ = 0;
+  };
+
+  /// encodes entries one after another
+  std::string encodeEntries(const std::vector<Entry> &entries) {
+    std::string data;
+    for (auto &entry : entries) {
+      auto encoded = scale::encode(entry).value();
+      data.append(encoded.begin(), encoded.end());
+    }
+    return data;
+  }
+}  // namespace
+
+/**
+ * @given consecutive encoded values in std::istream
+ * @when they are read by chunks of different sizes
+ * @then all the values are decoded, then the end of data is reported
+ */
+TEST(ScaleReader, ReadIstream) {
+  auto entries = makeEntries();
+  auto data = encodeEntries(entries);
+
+  for (size_t chunk_size : {1, 3, 100, 100000}) {
+    std::istringstream in{data};
+    ScaleReader<Entry> reader{ByteSource{in}, chunk_size};
+    for (auto &entry : entries) {
+      EXPECT_OUTCOME_TRUE(value, reader.next());
+      ASSERT_TRUE(value) << chunk_size;
+      EXPECT_EQ(*value, entry);
+    }
+    EXPECT_OUTCOME_TRUE(end, reader.next());
+    EXPECT_FALSE(end);
+  }
+}
+
+/**
+ * @given std::istream, which data comes in pieces
+ * @when it is read to a buffer larger than a piece
+ * @then each read returns the data available, without waiting for more
+ */
+TEST(ScaleReader, ReadAvailable) {
+  PieceBuffer buffer{{"abc", "de", "f"}};
+  std::istream in{&buffer};
+  ByteSource source{in};
+  ByteArray out(100);
+  for (size_t expected : {3, 2, 1, 0}) {
+    EXPECT_OUTCOME_TRUE(size, source.read(out));
+    EXPECT_EQ(size, expected);
+  }
+}
+
+/**
+ * @given consecutive encoded values in file
+ * @when they are read from file descriptor
+ * @then all the values are decoded
+ */
+TEST(ScaleReader, ReadFd) {
+  auto entries = makeEntries();
+  auto data = encodeEntries(entries);
+  std::unique_ptr<FILE, decltype(&fclose)> file{std::tmpfile(), &fclose};
+  ASSERT_TRUE(file);
+  ASSERT_EQ(fwrite(data.data(), 1, data.size(), file.get()), data.size());
+  fflush(file.get());
+  rewind(file.get());
+
+  ScaleReader<Entry> reader{ByteSource{fileno(file.get())}, 64};
+  for (auto &entry : entries) {
+    EXPECT_OUTCOME_TRUE(value, reader.next());
+    ASSERT_TRUE(value);
+    EXPECT_EQ(*value, entry);
+  }
+  EXPECT_OUTCOME_TRUE(end, reader.next());
+  EXPECT_FALSE(end);
+}
+
+/**
+ * @given data which ends in the middle of a value
+ * @when values are read
+ * @then complete values are decoded, then error is reported
+ */
+TEST(ScaleReader, Truncated) {
+  auto entries = makeEntries();
+  auto data = encodeEntries({entries[10], entries[20]});
+  data.pop_back();
+
+  std::istringstream in{data};
+  ScaleReader<Entry> reader{ByteSource{in}, 8};
+  EXPECT_OUTCOME_TRUE(value, reader.next());
+  EXPECT_EQ(value, entries[10]);
+  EXPECT_EC(reader.next(), DecodeError::NOT_ENOUGH_DATA);
+}
+
+/**
+ * @given consecutive encoded big compact integers
+ * @when they are read by chunks splitting them
+ * @then all the values are decoded
+ */
+TEST(ScaleReader, SplitCompactIntegers) {
+  std::vector<scale::CompactInteger> values;
+  scale::CompactInteger value = 1;
+  // the widest shift is 247 bits, which stays within 256 bits
+  for (size_t i = 0; i < 19; ++i) {
+    value <<= 13;
+    values.push_back(value);
+  }
+  values.push_back(~scale::CompactInteger{0});
+  std::string data;
+  for (auto &value : values) {
+    auto encoded = scale::encode(value).value();
+    data.append(encoded.begin(), encoded.end());
+  }
+
+  for (size_t chunk_size : {1, 2, 3, 5}) {
+    std::istringstream in{data};
+    ScaleReader<scale::CompactInteger> reader{ByteSource{in}, chunk_size};
+    for (auto &value : values) {
+      EXPECT_OUTCOME_TRUE(read, reader.next());
+      ASSERT_TRUE(read) << chunk_size;
+      EXPECT_EQ(*read, value);
+    }
+    EXPECT_OUTCOME_TRUE(end, reader.next());
+    EXPECT_FALSE(end);
+  }
+}
+
+/**
+ * @given file with encoded values
+ * @when it is mapped to memory
+ * @then values are decoded from the mapping
+ */
+TEST(MappedFile, Decode) {
+  auto entries = makeEntries();
+  auto path = std::filesystem::temp_directory_path() / "scale_mapped_file_test";
+  {
+    std::ofstream out{path, std::ios::binary};
+    auto encoded = scale::encode(entries).value();
+    out.write(reinterpret_cast<const char *>(encoded.data()),  // NOLINT
+              static_cast<std::streamsize>(encoded.size()));
+  }
+
+  EXPECT_OUTCOME_TRUE(file, MappedFile::open(path.string()));
+  using Entries = std::vector<Entry>;
+  EXPECT_OUTCOME_TRUE(decoded, scale::decode<Entries>(file.data()));
+  EXPECT_EQ(decoded, entries);
+
+  // mapping is still valid after move
+  auto moved = std::move(file);
+  EXPECT_OUTCOME_TRUE(again, scale::decode<Entries>(moved.data()));
+  EXPECT_EQ(again, entries);
+  std::filesystem::remove(path);
+
+  EXPECT_FALSE(MappedFile::open(path.string()).has_value());
+}
@@ -0,0 +1,164 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <cstdio>
+#include <sstream>
+
+#include <gtest/gtest.h>
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+#include "scale/scale.hpp"
+#include "util/outcome.hpp"
+
+using scale::ByteArray;
+using scale::ScaleSinkEncoderStream;
+
+namespace {
+  struct TestStruct {
+    uint32_t a;
+    std::string b;
+    std::vector<ByteArray> c;
+  };
+
+  template <class Stream,
+            typename = std::enable_if_t<Stream::is_encoder_stream>>
+  Stream &operator<<(Stream &s, const TestStruct &v) {
+    return s << v.a << v.b << v.c;
+  }
+
+  TestStruct makeValue() {
+    return {.a = 0x01020304,
+            .b = std::string(100, 'b'),
+            .c = {ByteArray(3, 1), ByteArray(40, 2), {}, ByteArray(1000, 3)}};
+  }
+
+  /// buffer of std::ostream, which counts or fails its synchronizations
+  class SyncingBuf : public std::stringbuf {
+   public:
+    explicit SyncingBuf(bool fail) : fail_{fail} {}
+
+    int syncs = 0;
+
+   protected:
+    int sync() override {
+      ++syncs;
+      return fail_ ? -1 : 0;
+    }
+
+   private:
+    bool fail_;
+  };
+}  // namespace
+
+/**
+ * @given a custom structure and buffers of different sizes
+ * @when the structure is encoded to std::ostream through the buffer
+ * @then the stream receives the same bytes as scale::encode() result
+ */
+TEST(ScaleSinkEncoderStreamTest, EncodeToOstream) {
+  auto value = makeValue();
+  EXPECT_OUTCOME_TRUE(expected, scale::encode(value));
+
+  for (size_t buffer_size : {0, 1, 7, 64, 4096}) {
+    std::ostringstream out;
+    {
+      ScaleSinkEncoderStream s{out, buffer_size};
+      s << value << value;
+      EXPECT_EQ(s.size(), expected.size() * 2);
+    }
+    auto written = out.str();
+    ASSERT_EQ(written.size(), expected.size() * 2) << buffer_size;
+    EXPECT_TRUE(std::equal(expected.begin(),
+                           expected.end(),
+                           reinterpret_cast<const uint8_t *>(written.data())));
+  }
+}
+
+#ifndef _WIN32
+/**
+ * @given a custom structure and a file
+ * @when the structure is encoded to the file descriptor and flushed
+ * @then the file contains the same bytes as scale::encode() result
+ */
+TEST(ScaleSinkEncoderStreamTest, EncodeToFd) {
+  auto value = makeValue();
+  EXPECT_OUTCOME_TRUE(expected, scale::encode(value));
+
+  std::unique_ptr<FILE, decltype(&fclose)> file{std::tmpfile(), &fclose};
+  ASSERT_TRUE(file);
+  auto fd = fileno(file.get());
+  ScaleSinkEncoderStream s{fd, 16};
+  s << value;
+  s.flush();
+  ASSERT_FALSE(s.error());
+  EXPECT_EQ(s.size(), expected.size());
+
+  ByteArray written(expected.size() + 1);
+  auto read = ::pread(fd, written.data(), written.size(), 0);
+  ASSERT_EQ(read, expected.size());
+  written.resize(expected.size());
+  EXPECT_EQ(written, expected);
+}
+
+/**
+ * @given a descriptor which can not be written to
+ * @when data is encoded to it by non-throwing stream
+ * @then the error of writing is recorded, size is still counted
+ */
+TEST(ScaleSinkEncoderStreamTest, WriteError) {
+  ScaleSinkEncoderStream s{-1, 4};
+  s.setThrowOnError(false);
+  s << makeValue();
+  EXPECT_EQ(s.error(), std::error_code(EBADF, std::system_category()));
+  EXPECT_EQ(s.size(), scale::encodedSize(makeValue()).value());
+}
+#endif
+
+/**
+ * @given std::ostream with its own buffer
+ * @when data is encoded to it and flushed
+ * @then the ostream is flushed as well, its failure is reported
+ */
+TEST(ScaleSinkEncoderStreamTest, FlushOstream) {
+  auto expected = scale::encode(makeValue()).value();
+
+  SyncingBuf buf{false};
+  std::ostream out{&buf};
+  ScaleSinkEncoderStream s{out};
+  s << makeValue();
+  EXPECT_EQ(buf.syncs, 0);
+  s.flush();
+  EXPECT_EQ(buf.syncs, 1);
+  EXPECT_FALSE(s.error());
+  auto written = buf.str();
+  EXPECT_EQ(ByteArray(written.begin(), written.end()), expected);
+
+  SyncingBuf failing_buf{true};
+  std::ostream failing_out{&failing_buf};
+  ScaleSinkEncoderStream failing{failing_out};
+  failing.setThrowOnError(false);
+  failing << makeValue();
+  failing.flush();
+  EXPECT_EQ(failing.error(), std::make_error_code(std::io_errc::stream));
+}
+
+/**
+ * @given std::ostream raising exceptions, which flushing fails
+ * @when stream writing to it is destroyed with buffered data
+ * @then the failure does not escape the destructor
+ */
+TEST(ScaleSinkEncoderStreamTest, DestroyWithThrowingOstream) {
+  SyncingBuf failing_buf{true};
+  std::ostream out{&failing_buf};
+  out.exceptions(std::ios_base::badbit);
+  {
+    ScaleSinkEncoderStream s{out};
+    s << makeValue();
+  }
+  EXPECT_TRUE(out.bad());
+}
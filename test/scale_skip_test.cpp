@@ -0,0 +1,138 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+
+#include <map>
+
+#include "scale/parallel.hpp"
+#include "scale/scale.hpp"
+#include "util/outcome.hpp"
+
+using scale::BitVec;
+using scale::ByteArray;
+using scale::CompactInteger;
+using scale::DecodeError;
+using scale::encode;
+using scale::encodedLength;
+using scale::ScaleDecoderStream;
+
+struct Block {
+  uint32_t number;
+  std::vector<std::string> extrinsics;
+  std::optional<std::map<uint8_t, ByteArray>> digest;
+  std::shared_ptr<CompactInteger> weight;
+};
+
+template <class Stream, typename = std::enable_if_t<Stream::is_encoder_stream>>
+Stream &operator<<(Stream &s, const Block &v) {
+  return s << v.number << v.extrinsics << v.digest << v.weight;
+}
+
+template <class Stream, typename = std::enable_if_t<Stream::is_decoder_stream>>
+Stream &operator>>(Stream &s, Block &v) {
+  return s >> v.number >> v.extrinsics >> v.digest >> v.weight;
+}
+
+/**
+ * @given sequence of encoded values of different types
+ * @when they are skipped one by one
+ * @then stream is advanced exactly over each of them and the last value is
+ * decoded correctly
+ */
+TEST(Skip, AdvancesOverEncodedValues) {
+  std::vector<Block> blocks{
+      {1, {"a", "bc"}, std::nullopt, std::make_shared<CompactInteger>(5)},
+      {2,
+       {},
+       std::map<uint8_t, ByteArray>{{1, {1, 2}}, {2, ByteArray(70, 3)}},
+       std::make_shared<CompactInteger>(1'000'000'000'000ull)}};
+  BitVec bits{true, false, true, true, false, false, true, false, true};
+  boost::variant<uint8_t, std::string> variant{std::string("variant")};
+  std::tuple<uint16_t, std::vector<uint32_t>, bool> tuple{
+      7, {1, 2, 3}, true};
+  EXPECT_OUTCOME_TRUE(
+      encoded, encode(blocks, bits, variant, tuple, std::vector<bool>{true},
+                      std::string("tail")));
+
+  ScaleDecoderStream s(encoded);
+  s.skip<std::vector<Block>>()
+      .skip<BitVec>()
+      .skip<boost::variant<uint8_t, std::string>>()
+      .skip<decltype(tuple)>()
+      .skip<std::vector<bool>>();
+  std::string tail;
+  s >> tail;
+  EXPECT_EQ(tail, "tail");
+  EXPECT_FALSE(s.hasMore(1));
+}
+
+/**
+ * @given encoded values
+ * @when encodedLength is called for them
+ * @then it is equal to size of encoding, regardless of trailing data
+ */
+TEST(Skip, EncodedLength) {
+  Block block{3, {"x"}, std::map<uint8_t, ByteArray>{{4, {5}}}, nullptr};
+  block.weight = std::make_shared<CompactInteger>(42);
+  EXPECT_OUTCOME_TRUE(encoded_block, encode(block));
+  auto with_tail = encoded_block;
+  with_tail.insert(with_tail.end(), {1, 2, 3});
+  EXPECT_OUTCOME_TRUE(block_length, encodedLength<Block>(with_tail));
+  EXPECT_EQ(block_length, encoded_block.size());
+
+  using Arrays = std::vector<std::array<uint32_t, 3>>;
+  Arrays arrays(10);
+  EXPECT_OUTCOME_TRUE(encoded_arrays, encode(arrays));
+  EXPECT_OUTCOME_TRUE(arrays_length, encodedLength<Arrays>(encoded_arrays));
+  EXPECT_EQ(arrays_length, encoded_arrays.size());
+
+  // skipping does not need borrowing stream to pass views
+  EXPECT_OUTCOME_TRUE(encoded_string, encode(std::string("abc")));
+  EXPECT_OUTCOME_TRUE(view_length,
+                      encodedLength<std::string_view>(encoded_string));
+  EXPECT_EQ(view_length, 4);
+}
+
+/**
+ * @given truncated encoded values
+ * @when they are skipped
+ * @then the same error as for decoding is returned
+ */
+TEST(Skip, TruncatedData) {
+  std::vector<std::vector<uint64_t>> values{{1, 2}, {3, 4, 5}};
+  EXPECT_OUTCOME_TRUE(encoded, encode(values));
+  encoded.pop_back();
+  EXPECT_EC(encodedLength<decltype(values)>(encoded),
+            DecodeError::NOT_ENOUGH_DATA);
+
+  // length is checked against the data before the size of items
+  ByteArray huge_length{0x13, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff};
+  EXPECT_EC(encodedLength<std::vector<uint64_t>>(huge_length),
+            DecodeError::NOT_ENOUGH_DATA);
+}
+
+/**
+ * @given values with length prefix close to the max value of size_t
+ * @when their encoded length is found
+ * @then NOT_ENOUGH_DATA error is returned instead of length wrapped around
+ */
+TEST(Skip, HugeLength) {
+  ByteArray encoded{0x13, 0xfe, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x61};
+  EXPECT_EC(encodedLength<std::string_view>(encoded),
+            DecodeError::NOT_ENOUGH_DATA);
+  EXPECT_EC(encodedLength<std::string>(encoded), DecodeError::NOT_ENOUGH_DATA);
+
+  // the same length of an item in the middle of collection
+  ByteArray nested{0x08, 0x04, 0x61};
+  nested.insert(nested.end(), encoded.begin(), encoded.end());
+  EXPECT_EC(encodedLength<std::vector<std::string>>(nested),
+            DecodeError::NOT_ENOUGH_DATA);
+  EXPECT_EC(scale::decodeBorrowed<scale::LazyVec<std::string>>(nested),
+            DecodeError::NOT_ENOUGH_DATA);
+  EXPECT_EC(scale::decodeParallel<std::string>(nested, 2),
+            DecodeError::NOT_ENOUGH_DATA);
+}
@@ -0,0 +1,75 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+
+#include "scale/scale.hpp"
+#include "util/outcome.hpp"
+
+using scale::ByteArray;
+using scale::EncodeError;
+using scale::encodeTo;
+using scale::ScaleSpanEncoderStream;
+
+struct TestStruct {
+  uint32_t a;
+  std::string b;
+  std::optional<uint16_t> c;
+};
+
+template <class Stream, typename = std::enable_if_t<Stream::is_encoder_stream>>
+Stream &operator<<(Stream &s, const TestStruct &v) {
+  return s << v.a << v.b << v.c;
+}
+
+/**
+ * @given a custom structure and a large enough buffer
+ * @when the structure is encoded to the buffer
+ * @then the buffer contains the same bytes as scale::encode() result
+ */
+TEST(ScaleSpanEncoderStreamTest, EncodeToBuffer) {
+  TestStruct value{.a = 0x01020304, .b = "abc", .c = 5};
+  EXPECT_OUTCOME_TRUE(expected, scale::encode(value));
+
+  std::array<uint8_t, 32> buffer{};
+  ScaleSpanEncoderStream s{buffer};
+  s << value;
+  ASSERT_FALSE(s.overflowed());
+  ASSERT_EQ(s.size(), expected.size());
+  ASSERT_EQ(ByteArray(s.data().begin(), s.data().end()), expected);
+}
+
+/**
+ * @given a buffer which is too small to fit encoded data
+ * @when data is encoded to the buffer
+ * @then overflow is reported and the required size is known
+ */
+TEST(ScaleSpanEncoderStreamTest, Overflow) {
+  TestStruct value{.a = 1, .b = "some long string", .c = std::nullopt};
+  EXPECT_OUTCOME_TRUE(expected, scale::encode(value));
+
+  std::array<uint8_t, 8> buffer{};
+  ScaleSpanEncoderStream s{buffer};
+  s << value;
+  ASSERT_TRUE(s.overflowed());
+  ASSERT_EQ(s.size(), expected.size());
+  ASSERT_EQ(s.data().size(), buffer.size());
+}
+
+/**
+ * @given values to encode
+ * @when they are encoded by encodeTo() to buffers of various sizes
+ * @then number of written bytes is returned if data fits the buffer
+ * @and BUFFER_TOO_SMALL error is returned otherwise
+ */
+TEST(ScaleSpanEncoderStreamTest, EncodeTo) {
+  std::array<uint8_t, 5> buffer{};
+  EXPECT_OUTCOME_TRUE(size, encodeTo(buffer, uint32_t{0x01020304}, true));
+  ASSERT_EQ(size, 5);
+  ASSERT_EQ(buffer, (std::array<uint8_t, 5>{4, 3, 2, 1, 1}));
+
+  EXPECT_EC(encodeTo(buffer, uint64_t{1}), EncodeError::BUFFER_TOO_SMALL);
+}
@@ -0,0 +1,106 @@
+/**
+ * Copyright Quadrivium LLC
+ * All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+
+#include "scale/scale.hpp"
+#include "util/outcome.hpp"
+
+using scale::ByteArray;
+using scale::DecodeError;
+using scale::encodeFixed;
+using scale::HasStaticEncodedSize;
+using scale::ScaleDecoderStream;
+using scale::static_encoded_size_v;
+using scale::UncheckedEncoding;
+
+namespace test {
+  enum class Kind : uint16_t { A, B };
+
+  struct StorageKey {
+    std::array<uint8_t, 16> prefix;
+    uint32_t index;
+  };
+
+  template <class Stream,
+            typename = std::enable_if_t<Stream::is_encoder_stream>>
+  Stream &operator<<(Stream &s, const StorageKey &v) {
+    return s << v.prefix << v.index;
+  }
+}  // namespace test
+
+SCALE_DEFINE_ENUM_VALUE_RANGE(test, Kind, test::Kind::A, test::Kind::B);
+
+template <>
+struct scale::static_encoded_size<test::StorageKey>
+    : std::integral_constant<size_t, 20> {};
+
+static_assert(static_encoded_size_v<bool> == 1);
+static_assert(static_encoded_size_v<int64_t> == 8);
+static_assert(static_encoded_size_v<test::Kind> == 2);
+static_assert(static_encoded_size_v<std::array<uint8_t, 32>> == 32);
+static_assert(static_encoded_size_v<std::pair<uint8_t, uint32_t>> == 5);
+static_assert(
+    static_encoded_size_v<
+        std::tuple<test::Kind, std::array<std::pair<bool, int32_t>, 2>>>
+    == 12);
+static_assert(static_encoded_size_v<test::StorageKey> == 20);
+static_assert(not HasStaticEncodedSize<std::string>);
+static_assert(not HasStaticEncodedSize<std::optional<uint8_t>>);
+static_assert(not HasStaticEncodedSize<std::tuple<uint8_t, ByteArray>>);
+static_assert(not HasStaticEncodedSize<std::array<ByteArray, 2>>);
+
+static_assert(UncheckedEncoding<uint32_t>);
+static_assert(UncheckedEncoding<std::tuple<int8_t, std::array<uint16_t, 2>>>);
+static_assert(not UncheckedEncoding<bool>);
+static_assert(not UncheckedEncoding<test::Kind>);
+static_assert(not UncheckedEncoding<std::pair<uint8_t, bool>>);
+static_assert(not UncheckedEncoding<test::StorageKey>);
+static_assert(not UncheckedEncoding<std::string>);
+
+/**
+ * @given values of types with static encoded size
+ * @when they are encoded by encodeFixed
+ * @then the result is the same as of scale::encode()
+ */
+TEST(StaticEncodedSize, EncodeFixed) {
+  auto value = std::make_tuple(
+      test::Kind::B, uint32_t{0x01020304}, std::array<uint8_t, 3>{5, 6, 7});
+  std::array<uint8_t, 9> fixed = encodeFixed(value);
+  EXPECT_OUTCOME_TRUE(encoded, scale::encode(value));
+  ASSERT_EQ(ByteArray(fixed.begin(), fixed.end()), encoded);
+
+  test::StorageKey key{.prefix = {1, 2, 3}, .index = 4};
+  auto fixed_key = encodeFixed(key);
+  EXPECT_OUTCOME_TRUE(encoded_key, scale::encode(key));
+  ASSERT_EQ(ByteArray(fixed_key.begin(), fixed_key.end()), encoded_key);
+}
+
+/**
+ * @given truncated data of a tuple having static encoded size
+ * @when the tuple is decoded
+ * @then decoding fails before any element is decoded
+ */
+TEST(StaticEncodedSize, DecodeChecksSizeAtOnce) {
+  ByteArray bytes{1, 2, 3, 4, 5};
+  ScaleDecoderStream s{bytes};
+  std::tuple<uint8_t, uint32_t, uint8_t> value{};
+  ASSERT_ANY_THROW(s >> value);
+  ASSERT_EQ(s.currentIndex(), 0);
+  ASSERT_EQ(std::get<0>(value), 0);
+}
+
+/**
+ * @given encoded collection which declares more items of static encoded size
+ * than it contains
+ * @when it is decoded
+ * @then NOT_ENOUGH_DATA error is returned
+ */
+TEST(StaticEncodedSize, DecodeCollectionChecksSizeAtOnce) {
+  ByteArray bytes{12, 1, 2, 3, 4, 5, 6, 7};
+  EXPECT_EC((scale::decode<std::vector<std::pair<uint8_t, uint16_t>>>(bytes)),
+            DecodeError::NOT_ENOUGH_DATA);
+}
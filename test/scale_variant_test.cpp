@@ -76,3 +76,86 @@ TEST(ScaleVariant, DecodeU32Success) {
   ASSERT_NO_THROW(s >> val);
   ASSERT_EQ(boost::get<uint32_t>(val), 1);
 }
+
+/**
+ * @given values of std::variant and boost::variant of the same types
+ * @when they are encoded and decoded back
+ * @then encoded bytes are the same and decoded values are equal to original
+ */
+TEST(ScaleVariant, StdVariantSameAsBoost) {
+  using Std = std::variant<std::monostate, uint32_t, std::string, ByteArray>;
+  using Boost = boost::variant<uint32_t, std::string, ByteArray>;
+
+  EXPECT_OUTCOME_TRUE(empty, encode(Std{}));
+  EXPECT_EQ(empty, (ByteArray{0}));
+
+  for (auto [std_value, boost_value] :
+       {std::pair<Std, Boost>{uint32_t{7}, uint32_t{7}},
+        {std::string("abc"), std::string("abc")},
+        {ByteArray{1, 2, 3}, ByteArray{1, 2, 3}}}) {
+    EXPECT_OUTCOME_TRUE(std_encoded, encode(std_value));
+    EXPECT_OUTCOME_TRUE(boost_encoded, encode(boost_value));
+    // std variant has extra alternative in front
+    ASSERT_EQ(std_encoded.size(), boost_encoded.size());
+    EXPECT_EQ(std_encoded[0], boost_encoded[0] + 1);
+    EXPECT_TRUE(std::equal(
+        std_encoded.begin() + 1, std_encoded.end(), boost_encoded.begin() + 1));
+
+    EXPECT_OUTCOME_TRUE(std_decoded, decode<Std>(std_encoded));
+    EXPECT_TRUE(std_decoded == std_value);
+    EXPECT_OUTCOME_TRUE(boost_decoded, decode<Boost>(boost_encoded));
+    EXPECT_TRUE(boost_decoded == boost_value);
+  }
+}
+
+/**
+ * @given encoded variant with index of missing alternative
+ * @when it is decoded as std::variant
+ * @then WRONG_TYPE_INDEX error is reported
+ */
+TEST(ScaleVariant, StdVariantWrongIndex) {
+  using Std = std::variant<uint8_t, uint32_t>;
+  EXPECT_EC(decode<Std>(ByteArray{2, 0}), scale::DecodeError::WRONG_TYPE_INDEX);
+}
+
+namespace {
+  template <size_t I>
+  struct Call {
+    uint32_t arg;
+    bool operator==(const Call &) const = default;
+  };
+
+  template <class Stream,
+            size_t I,
+            typename = std::enable_if_t<Stream::is_encoder_stream>>
+  Stream &operator<<(Stream &s, const Call<I> &v) {
+    return s << v.arg;
+  }
+
+  template <class Stream,
+            size_t I,
+            typename = std::enable_if_t<Stream::is_decoder_stream>>
+  Stream &operator>>(Stream &s, Call<I> &v) {
+    return s >> v.arg;
+  }
+
+  template <size_t... I>
+  auto makeCalls(std::index_sequence<I...>) -> std::variant<Call<I>...>;
+}  // namespace
+
+/**
+ * @given variant of many alternatives
+ * @when each of them is encoded and decoded back
+ * @then type index is the index of alternative, values are equal
+ */
+TEST(ScaleVariant, ManyAlternatives) {
+  using Calls = decltype(makeCalls(std::make_index_sequence<60>{}));
+  Calls calls = Call<0>{0};
+  EXPECT_OUTCOME_TRUE(first, encode(calls));
+  EXPECT_EQ(first, (ByteArray{0, 0, 0, 0, 0}));
+  calls = Call<59>{0x01020304};
+  EXPECT_OUTCOME_TRUE(last, encode(calls));
+  EXPECT_EQ(last, (ByteArray{59, 4, 3, 2, 1}));
+  EXPECT_OUTCOME_TRUE(decoded, decode<Calls>(last));
+  EXPECT_TRUE(decoded == calls);
+}